@@ -28,8 +28,6 @@ import (
 
 	"github.com/bubblesupreme/git-stories/git_info/linter"
 
-	"google.golang.org/protobuf/proto"
-
 	log "github.com/sirupsen/logrus"
 )
 
@@ -48,9 +46,30 @@ type Linter struct {
 	Parameters []string `json:"parameters"`
 }
 
+// Source tells where the repository comes from. Path is a local repository
+// used in place, Mirror a folder that keeps a bare clone between runs and
+// is updated with a fetch. Without either the repository is cloned into
+// the working folder.
+type Source struct {
+	Path   string `json:"path"`
+	Mirror string `json:"mirror"`
+}
+
+// Output tells how the .gs file is written. With a Path the file is kept
+// there between runs and only commits after the last one it records are
+// appended to it. With Stream the renderer starts right away and reads the
+// commits from a pipe as they are produced.
+type Output struct {
+	Path       string `json:"path"`
+	Compressed bool   `json:"compressed"`
+	Stream     bool   `json:"stream"`
+}
+
 type Config struct {
 	User    User     `json:"user"`
+	Source  Source   `json:"source"`
 	Linters []Linter `json:"linters"`
+	Output  Output   `json:"output"`
 }
 
 func ParseJsonConfig(filePath string) (*Config, error) {
@@ -82,6 +101,14 @@ func (config *Config) GetUser() User {
 	return config.User
 }
 
+func (config *Config) GetSource() Source {
+	return config.Source
+}
+
+func (config *Config) GetOutput() Output {
+	return config.Output
+}
+
 func (config *Config) GetLinters() ([]linter.ILinter, error) {
 
 	ILinters := make([]linter.ILinter, 0, len(config.Linters))
@@ -101,33 +128,3 @@ func (config *Config) GetLinters() ([]linter.ILinter, error) {
 
 	return ILinters, nil
 }
-
-func (config *OutConfig) WriteResults(filePath string) error {
-	file, err := os.Create(filePath)
-	if err != nil {
-		log.WithFields(log.Fields{
-			"filePath": filePath,
-		}).Error("Failed to create file.")
-		return err
-	}
-
-	data, err := proto.Marshal(config)
-	if err != nil {
-		log.WithFields(log.Fields{
-			"config": config,
-		}).Error("Failed to encode struct OutConfig to bytes.")
-		return err
-	}
-
-	_, err = file.Write(data)
-	if err != nil {
-		log.WithFields(log.Fields{
-			"file": file,
-		}).Error("Failed to write bytes to file.")
-		return err
-	}
-
-	// fmt.Println(data)
-
-	return nil
-}
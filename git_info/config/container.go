@@ -0,0 +1,714 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+package config
+
+import (
+	"bufio"
+	"bytes"
+	"compress/zlib"
+	"encoding/binary"
+	"errors"
+	"io"
+	"os"
+
+	"google.golang.org/protobuf/proto"
+
+	log "github.com/sirupsen/logrus"
+)
+
+// A .gs file is a header, one varint length-delimited CommitInfo per
+// commit and a trailer:
+//
+//	header:  "GSTM", uint32 version, uint64 commit count
+//	index:   one indexEntrySize entry per commit
+//	         uint64 record offset, int64 timestamp, int32 errors,
+//	         uint32 new, deleted and changed file counts
+//	         PathDictionary with every path of the history
+//	footer:  uint64 index offset, uint64 dictionary offset, "GSIX",
+//	         uint32 indexEntrySize
+//
+// All integers are little-endian. The trailer lets a reader find any
+// commit without scanning the records before it. Its PathDictionary is the
+// only one in the file, records carry no dictionary of their own.
+//
+// A compressed file has version 3. Its header is followed by uint32
+// blockCommits and four reserved bytes, and the records are grouped into
+// blocks of blockCommits commits compressed independently with zlib. A
+// block that does not shrink is stored as is. The trailer starts with a
+// blockEntrySize entry per block, uint64 offset, uint32 stored size and
+// uint32 raw size, and record offsets in the index are relative to the
+// start of the raw block.
+//
+// A streamed file has version 1, a commit count with all bits set and no
+// trailer. The reader counts the records as they arrive until the stream
+// ends. Every record carries the dictionary entries it adds, a reader
+// merges them in commit order.
+const (
+	containerMagic       = "GSTM"
+	containerVersion     = 2
+	containerHeaderSize  = 16
+	compressedVersion    = 3
+	compressedHeaderSize = 24
+	blockCommits         = 256
+	blockEntrySize       = 16
+	trailerMagic         = "GSIX"
+	indexEntrySize       = 32
+	footerSize           = 24
+	streamVersion        = 1
+	streamCount          = ^uint64(0)
+)
+
+type countingWriter struct {
+	writer io.Writer
+	offset uint64
+}
+
+func (w *countingWriter) Write(data []byte) (int, error) {
+	n, err := w.writer.Write(data)
+	w.offset += uint64(n)
+	return n, err
+}
+
+// writeRecords writes the commits and fills their index entries. The
+// dictionaries of the commits are dropped unless deltas is set, a file
+// with a trailer has the whole dictionary there.
+func writeRecords(writer *countingWriter, commits []*CommitInfo, index []byte, deltas bool) error {
+	length := make([]byte, binary.MaxVarintLen64)
+	for i, commit := range commits {
+		record := commit
+		if !deltas && commit.Dictionary != nil {
+			// the commit may be streamed at the same time, so it is not changed
+			record = proto.Clone(commit).(*CommitInfo)
+			record.Dictionary = nil
+		}
+		data, err := proto.Marshal(record)
+		if err != nil {
+			log.WithFields(log.Fields{
+				"commit": commit,
+			}).Error("Failed to encode struct CommitInfo to bytes.")
+			return err
+		}
+
+		entry := index[i*indexEntrySize:]
+		binary.LittleEndian.PutUint64(entry[0:], writer.offset)
+		binary.LittleEndian.PutUint64(entry[8:], uint64(commit.Timestamp))
+		binary.LittleEndian.PutUint32(entry[16:], uint32(commit.Errors))
+		binary.LittleEndian.PutUint32(entry[20:],
+			uint32(len(commit.NewFiles)+len(commit.NewFileIds)))
+		binary.LittleEndian.PutUint32(entry[24:],
+			uint32(len(commit.DeletedFiles)+len(commit.DeletedFileIds)))
+		binary.LittleEndian.PutUint32(entry[28:],
+			uint32(len(commit.ChangedFiles)+len(commit.ChangedFileIds)))
+
+		n := binary.PutUvarint(length, uint64(len(data)))
+		_, err = writer.Write(length[:n])
+		if err == nil {
+			_, err = writer.Write(data)
+		}
+		if err != nil {
+			log.Error("Failed to write commit to file.")
+			return err
+		}
+	}
+	return nil
+}
+
+// writeBlocks writes the commits as compressed blocks of perBlock commits
+// and returns their block entries. The first block starts with prefix, the
+// raw records of prefixCommits commits that are already in the file.
+func writeBlocks(writer *countingWriter, commits []*CommitInfo, index []byte,
+	perBlock int, prefix []byte, prefixCommits int) ([]byte, error) {
+	var blocks []byte
+	var compressed bytes.Buffer
+	for start := 0; start < len(commits); {
+		end := start + perBlock - prefixCommits
+		if end > len(commits) {
+			end = len(commits)
+		}
+		var raw bytes.Buffer
+		raw.Write(prefix)
+		err := writeRecords(&countingWriter{writer: &raw, offset: uint64(len(prefix))},
+			commits[start:end], index[start*indexEntrySize:], false)
+		if err != nil {
+			return nil, err
+		}
+		data := raw.Bytes()
+		prefix, prefixCommits = nil, 0
+
+		compressed.Reset()
+		zipper := zlib.NewWriter(&compressed)
+		_, err = zipper.Write(data)
+		if err == nil {
+			err = zipper.Close()
+		}
+		if err != nil {
+			log.Error("Failed to compress block.")
+			return nil, err
+		}
+		stored := data
+		if compressed.Len() < len(data) {
+			stored = compressed.Bytes()
+		}
+
+		entry := make([]byte, blockEntrySize)
+		binary.LittleEndian.PutUint64(entry[0:], writer.offset)
+		binary.LittleEndian.PutUint32(entry[8:], uint32(len(stored)))
+		binary.LittleEndian.PutUint32(entry[12:], uint32(len(data)))
+		blocks = append(blocks, entry...)
+		_, err = writer.Write(stored)
+		if err != nil {
+			log.Error("Failed to write block to file.")
+			return nil, err
+		}
+		start = end
+	}
+	return blocks, nil
+}
+
+// writeTrailer writes the block table, the index, the dictionary and the
+// footer after the records.
+func writeTrailer(writer *countingWriter, blocks []byte, index []byte, pathDictionary *PathDictionary) error {
+	dictionary, err := proto.Marshal(pathDictionary)
+	if err != nil {
+		log.Error("Failed to encode struct PathDictionary to bytes.")
+		return err
+	}
+
+	indexOffset := writer.offset + uint64(len(blocks))
+	footer := make([]byte, footerSize)
+	binary.LittleEndian.PutUint64(footer[0:], indexOffset)
+	binary.LittleEndian.PutUint64(footer[8:], indexOffset+uint64(len(index)))
+	copy(footer[16:], trailerMagic)
+	binary.LittleEndian.PutUint32(footer[20:], indexEntrySize)
+	for _, data := range [][]byte{blocks, index, dictionary, footer} {
+		_, err = writer.Write(data)
+		if err != nil {
+			log.Error("Failed to write trailer to file.")
+			return err
+		}
+	}
+	return nil
+}
+
+// WriteResults writes the commits in the container format described above,
+// in compressed blocks if compressed is set.
+func (config *OutConfig) WriteResults(filePath string, compressed bool) error {
+	file, err := os.Create(filePath)
+	if err != nil {
+		log.WithFields(log.Fields{
+			"filePath": filePath,
+		}).Error("Failed to create file.")
+		return err
+	}
+	defer file.Close()
+
+	buffered := bufio.NewWriter(file)
+	writer := &countingWriter{writer: buffered}
+	header := make([]byte, containerHeaderSize)
+	copy(header, containerMagic)
+	binary.LittleEndian.PutUint32(header[4:], containerVersion)
+	binary.LittleEndian.PutUint64(header[8:], uint64(len(config.Commits)))
+	if compressed {
+		header = append(header, make([]byte, compressedHeaderSize-containerHeaderSize)...)
+		binary.LittleEndian.PutUint32(header[4:], compressedVersion)
+		binary.LittleEndian.PutUint32(header[16:], blockCommits)
+	}
+	_, err = writer.Write(header)
+	if err != nil {
+		log.WithFields(log.Fields{
+			"file": file,
+		}).Error("Failed to write header to file.")
+		return err
+	}
+
+	index := make([]byte, len(config.Commits)*indexEntrySize)
+	var blocks []byte
+	if compressed {
+		blocks, err = writeBlocks(writer, config.Commits, index, blockCommits, nil, 0)
+	} else {
+		err = writeRecords(writer, config.Commits, index, false)
+	}
+	if err == nil {
+		err = writeTrailer(writer, blocks, index, config.GetDictionary())
+	}
+	if err != nil {
+		log.WithFields(log.Fields{
+			"file": file,
+		}).Error("Failed to write commits to file.")
+		return err
+	}
+
+	err = buffered.Flush()
+	if err != nil {
+		log.WithFields(log.Fields{
+			"file": file,
+		}).Error("Failed to write bytes to file.")
+		return err
+	}
+
+	return nil
+}
+
+var errNoTrailer = errors.New("file is not a .gs file with a trailer")
+
+// container is an existing .gs file with a trailer.
+type container struct {
+	file         *os.File
+	version      uint32
+	count        uint64
+	blockCommits uint64
+	// the records end where the block table or the index starts
+	recordsEnd uint64
+	blocks     []byte
+	index      []byte
+	dictionary *PathDictionary
+}
+
+func openContainer(filePath string) (*container, error) {
+	file, err := os.OpenFile(filePath, os.O_RDWR, 0)
+	if err != nil {
+		return nil, err
+	}
+	c := &container{file: file}
+	err = c.readTrailer()
+	if err != nil {
+		file.Close()
+		return nil, err
+	}
+	return c, nil
+}
+
+func (c *container) readTrailer() error {
+	info, err := c.file.Stat()
+	if err != nil {
+		return err
+	}
+	size := uint64(info.Size())
+	if size < containerHeaderSize+footerSize {
+		return errNoTrailer
+	}
+
+	header := make([]byte, compressedHeaderSize)
+	_, err = c.file.ReadAt(header[:containerHeaderSize], 0)
+	if err != nil {
+		return err
+	}
+	if string(header[:len(containerMagic)]) != containerMagic {
+		return errNoTrailer
+	}
+	c.version = binary.LittleEndian.Uint32(header[4:])
+	c.count = binary.LittleEndian.Uint64(header[8:])
+	headerSize := uint64(containerHeaderSize)
+	if c.version == compressedVersion {
+		headerSize = compressedHeaderSize
+		_, err = c.file.ReadAt(header[containerHeaderSize:], containerHeaderSize)
+		if err != nil {
+			return err
+		}
+		c.blockCommits = uint64(binary.LittleEndian.Uint32(header[16:]))
+		if c.blockCommits == 0 {
+			return errNoTrailer
+		}
+	} else if c.version != containerVersion {
+		return errNoTrailer
+	}
+
+	footer := make([]byte, footerSize)
+	_, err = c.file.ReadAt(footer, int64(size-footerSize))
+	if err != nil {
+		return err
+	}
+	if string(footer[16:20]) != trailerMagic ||
+		binary.LittleEndian.Uint32(footer[20:]) != indexEntrySize {
+		return errNoTrailer
+	}
+	indexOffset := binary.LittleEndian.Uint64(footer[0:])
+	dictionaryOffset := binary.LittleEndian.Uint64(footer[8:])
+	if c.count > size/indexEntrySize || indexOffset < headerSize ||
+		indexOffset+c.count*indexEntrySize != dictionaryOffset ||
+		dictionaryOffset > size-footerSize {
+		return errNoTrailer
+	}
+
+	c.recordsEnd = indexOffset
+	if c.version == compressedVersion {
+		blocksSize := (c.count + c.blockCommits - 1) / c.blockCommits * blockEntrySize
+		if indexOffset-headerSize < blocksSize {
+			return errNoTrailer
+		}
+		c.recordsEnd = indexOffset - blocksSize
+		c.blocks = make([]byte, blocksSize)
+		_, err = c.file.ReadAt(c.blocks, int64(c.recordsEnd))
+		if err != nil {
+			return err
+		}
+	}
+
+	c.index = make([]byte, c.count*indexEntrySize)
+	_, err = c.file.ReadAt(c.index, int64(indexOffset))
+	if err != nil {
+		return err
+	}
+
+	dictionary := make([]byte, size-footerSize-dictionaryOffset)
+	_, err = c.file.ReadAt(dictionary, int64(dictionaryOffset))
+	if err != nil {
+		return err
+	}
+	c.dictionary = &PathDictionary{}
+	return proto.Unmarshal(dictionary, c.dictionary)
+}
+
+// readBlock returns the raw records of a block of a compressed file.
+func (c *container) readBlock(block uint64) ([]byte, error) {
+	entry := c.blocks[block*blockEntrySize:]
+	offset := binary.LittleEndian.Uint64(entry[0:])
+	stored := binary.LittleEndian.Uint32(entry[8:])
+	rawSize := binary.LittleEndian.Uint32(entry[12:])
+	if offset > c.recordsEnd || uint64(stored) > c.recordsEnd-offset {
+		return nil, errNoTrailer
+	}
+	data := make([]byte, stored)
+	_, err := c.file.ReadAt(data, int64(offset))
+	if err != nil || stored == rawSize {
+		return data, err
+	}
+
+	reader, err := zlib.NewReader(bytes.NewReader(data))
+	if err != nil {
+		return nil, err
+	}
+	defer reader.Close()
+	raw := make([]byte, rawSize)
+	_, err = io.ReadFull(reader, raw)
+	if err != nil {
+		return nil, err
+	}
+	return raw, nil
+}
+
+// lastCommit decodes the last record of the file.
+func (c *container) lastCommit() (*CommitInfo, error) {
+	last := c.count - 1
+	offset := binary.LittleEndian.Uint64(c.index[last*indexEntrySize:])
+	var data []byte
+	if c.blocks != nil {
+		raw, err := c.readBlock(last / c.blockCommits)
+		if err != nil {
+			return nil, err
+		}
+		if offset > uint64(len(raw)) {
+			return nil, errNoTrailer
+		}
+		data = raw[offset:]
+	} else {
+		if offset > c.recordsEnd {
+			return nil, errNoTrailer
+		}
+		data = make([]byte, c.recordsEnd-offset)
+		_, err := c.file.ReadAt(data, int64(offset))
+		if err != nil {
+			return nil, err
+		}
+	}
+
+	length, n := binary.Uvarint(data)
+	if n <= 0 || length > uint64(len(data)-n) {
+		return nil, errNoTrailer
+	}
+	commit := &CommitInfo{}
+	err := proto.Unmarshal(data[n:uint64(n)+length], commit)
+	if err != nil {
+		return nil, err
+	}
+	return commit, nil
+}
+
+// ReadHistory returns the number of commits in the .gs file at filePath,
+// the last one, or nil if there are none, and the dictionary of every path
+// they use.
+func ReadHistory(filePath string) (uint64, *CommitInfo, *PathDictionary, error) {
+	c, err := openContainer(filePath)
+	if err != nil {
+		return 0, nil, nil, err
+	}
+	defer c.file.Close()
+
+	if c.count == 0 {
+		return 0, nil, c.dictionary, nil
+	}
+	commit, err := c.lastCommit()
+	if err != nil {
+		log.WithFields(log.Fields{
+			"filePath": filePath,
+		}).Error("Failed to read the last commit.")
+		return 0, nil, nil, err
+	}
+	return c.count, commit, c.dictionary, nil
+}
+
+// AppendResults adds the commits at the end of the .gs file at filePath in
+// its own format. The records in the file are kept and only the trailer is
+// replaced, along with the last block of a compressed file if it is not
+// full. The dictionary must hold the paths of the whole history.
+func AppendResults(filePath string, commits []*CommitInfo, dictionary *PathDictionary) error {
+	if len(commits) == 0 {
+		return nil
+	}
+	c, err := openContainer(filePath)
+	if err != nil {
+		log.WithFields(log.Fields{
+			"filePath": filePath,
+		}).Error("Failed to open file.")
+		return err
+	}
+	defer c.file.Close()
+
+	index := append(c.index, make([]byte, len(commits)*indexEntrySize)...)
+	var blocks, prefix []byte
+	var prefixCommits int
+	end := c.recordsEnd
+	if c.blocks != nil {
+		full := c.count / c.blockCommits
+		blocks = c.blocks[:full*blockEntrySize]
+		if c.count%c.blockCommits != 0 {
+			prefix, err = c.readBlock(full)
+			if err != nil {
+				log.WithFields(log.Fields{
+					"filePath": filePath,
+				}).Error("Failed to read the last block.")
+				return err
+			}
+			prefixCommits = int(c.count % c.blockCommits)
+			end = binary.LittleEndian.Uint64(c.blocks[full*blockEntrySize:])
+		}
+	}
+
+	err = c.file.Truncate(int64(end))
+	if err == nil {
+		_, err = c.file.Seek(int64(end), io.SeekStart)
+	}
+	if err != nil {
+		log.WithFields(log.Fields{
+			"filePath": filePath,
+		}).Error("Failed to truncate file.")
+		return err
+	}
+
+	buffered := bufio.NewWriter(c.file)
+	writer := &countingWriter{writer: buffered, offset: end}
+	newIndex := index[c.count*indexEntrySize:]
+	if c.blocks != nil {
+		var newBlocks []byte
+		newBlocks, err = writeBlocks(writer, commits, newIndex,
+			int(c.blockCommits), prefix, prefixCommits)
+		blocks = append(blocks, newBlocks...)
+	} else {
+		err = writeRecords(writer, commits, newIndex, false)
+	}
+	if err == nil {
+		err = writeTrailer(writer, blocks, index, dictionary)
+	}
+	if err == nil {
+		err = buffered.Flush()
+	}
+	if err != nil {
+		log.WithFields(log.Fields{
+			"filePath": filePath,
+		}).Error("Failed to append commits to file.")
+		return err
+	}
+
+	// the count goes last, until then the trailer does not match the header
+	// and a reader treats the file as having none
+	count := make([]byte, 8)
+	binary.LittleEndian.PutUint64(count, c.count+uint64(len(commits)))
+	_, err = c.file.WriteAt(count, 8)
+	if err == nil {
+		err = c.file.Sync()
+	}
+	if err != nil {
+		log.WithFields(log.Fields{
+			"filePath": filePath,
+		}).Error("Failed to write header to file.")
+		return err
+	}
+	return nil
+}
+
+// StreamWriter writes commits as a streamed file, each record is flushed
+// as soon as it is written.
+type StreamWriter struct {
+	writer *bufio.Writer
+	entry  []byte
+}
+
+func CreateStreamWriter(writer io.Writer) (*StreamWriter, error) {
+	stream := &StreamWriter{
+		writer: bufio.NewWriter(writer),
+		entry:  make([]byte, indexEntrySize),
+	}
+	header := make([]byte, containerHeaderSize)
+	copy(header, containerMagic)
+	binary.LittleEndian.PutUint32(header[4:], streamVersion)
+	binary.LittleEndian.PutUint64(header[8:], streamCount)
+	_, err := stream.writer.Write(header)
+	if err == nil {
+		err = stream.writer.Flush()
+	}
+	if err != nil {
+		log.Error("Failed to write header to stream.")
+		return nil, err
+	}
+	return stream, nil
+}
+
+func (stream *StreamWriter) Write(commit *CommitInfo) error {
+	err := writeRecords(&countingWriter{writer: stream.writer}, []*CommitInfo{commit}, stream.entry, true)
+	if err == nil {
+		err = stream.writer.Flush()
+	}
+	if err != nil {
+		log.WithFields(log.Fields{
+			"commit": commit.GetHash(),
+		}).Error("Failed to write commit to stream.")
+		return err
+	}
+	return nil
+}
+
+// History is the part of a .gs file that a stream starts with. It can be
+// copied while commits are appended to the file: AppendResults leaves the
+// records before the last partial block as they are, and that block is
+// read when the history is opened.
+type History struct {
+	c *container
+	// the full blocks of a compressed file, the rest is in tail
+	blocks uint64
+	tail   []byte
+	// the block being copied and what is left of it
+	block uint64
+	raw   []byte
+}
+
+// OpenHistory reads what AppendResults may rewrite in the .gs file at
+// filePath. The history must be closed after it is copied.
+func OpenHistory(filePath string) (*History, error) {
+	c, err := openContainer(filePath)
+	if err != nil {
+		log.WithFields(log.Fields{
+			"filePath": filePath,
+		}).Error("Failed to open file.")
+		return nil, err
+	}
+
+	history := &History{c: c}
+	if c.blocks != nil {
+		history.blocks = c.count / c.blockCommits
+		if c.count%c.blockCommits != 0 {
+			history.tail, err = c.readBlock(history.blocks)
+			if err != nil {
+				log.WithFields(log.Fields{
+					"filePath": filePath,
+				}).Error("Failed to read the last block.")
+				c.file.Close()
+				return nil, err
+			}
+		}
+	}
+	return history, nil
+}
+
+func (history *History) Close() error {
+	return history.c.file.Close()
+}
+
+// Read returns the raw records of a compressed history, one block at a
+// time.
+func (history *History) Read(data []byte) (int, error) {
+	for len(history.raw) == 0 {
+		if history.block > history.blocks {
+			return 0, io.EOF
+		}
+		if history.block == history.blocks {
+			history.raw = history.tail
+		} else {
+			raw, err := history.c.readBlock(history.block)
+			if err != nil {
+				return 0, err
+			}
+			history.raw = raw
+		}
+		history.block++
+	}
+	n := copy(data, history.raw)
+	history.raw = history.raw[n:]
+	return n, nil
+}
+
+// copyFirst copies the first record of a history to the stream with the
+// whole dictionary of the history, which its file keeps in the trailer.
+func (stream *StreamWriter) copyFirst(records *bufio.Reader, dictionary *PathDictionary) error {
+	length, err := binary.ReadUvarint(records)
+	if err != nil {
+		return err
+	}
+	data := make([]byte, length)
+	_, err = io.ReadFull(records, data)
+	if err != nil {
+		return err
+	}
+	commit := &CommitInfo{}
+	err = proto.Unmarshal(data, commit)
+	if err != nil {
+		return err
+	}
+	if commit.Dictionary == nil {
+		commit.Dictionary = dictionary
+	}
+	return writeRecords(&countingWriter{writer: stream.writer}, []*CommitInfo{commit}, stream.entry, true)
+}
+
+// CopyHistory writes the records of the history to the stream.
+func (stream *StreamWriter) CopyHistory(history *History) error {
+	c := history.c
+	var records io.Reader = history
+	if c.blocks == nil {
+		headerSize := int64(containerHeaderSize)
+		records = io.NewSectionReader(c.file, headerSize, int64(c.recordsEnd)-headerSize)
+	}
+	buffered := bufio.NewReader(records)
+	var err error
+	if c.count > 0 {
+		err = stream.copyFirst(buffered, c.dictionary)
+	}
+	if err == nil {
+		_, err = io.Copy(stream.writer, buffered)
+	}
+	if err == nil {
+		err = stream.writer.Flush()
+	}
+	if err != nil {
+		log.Error("Failed to copy history to stream.")
+		return err
+	}
+	return nil
+}
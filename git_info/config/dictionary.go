@@ -0,0 +1,113 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+package config
+
+import (
+	"strings"
+)
+
+type pathKey struct {
+	parent    uint32
+	component uint32
+}
+
+// PathEncoder interns path components and nodes across commits. Every
+// Encode call reports only the entries it added, so a reader that merges
+// the deltas in commit order rebuilds the same dictionary.
+type PathEncoder struct {
+	components map[string]uint32
+	nodes      map[pathKey]uint32
+	dictionary *PathDictionary
+}
+
+func CreatePathEncoder() *PathEncoder {
+	return &PathEncoder{
+		components: make(map[string]uint32),
+		nodes:      make(map[pathKey]uint32),
+		dictionary: &PathDictionary{},
+	}
+}
+
+// CreatePathEncoderFrom continues encoding after the commits that built
+// dictionary.
+func CreatePathEncoderFrom(dictionary *PathDictionary) *PathEncoder {
+	encoder := CreatePathEncoder()
+	for id, name := range dictionary.GetComponents() {
+		encoder.components[name] = uint32(id)
+	}
+	for id, node := range dictionary.GetNodes() {
+		key := pathKey{parent: node.GetParent(), component: node.GetComponent()}
+		encoder.nodes[key] = uint32(id) + 1
+	}
+	encoder.dictionary.Components = append(encoder.dictionary.Components,
+		dictionary.GetComponents()...)
+	encoder.dictionary.Nodes = append(encoder.dictionary.Nodes, dictionary.GetNodes()...)
+	return encoder
+}
+
+// Dictionary returns every entry added so far.
+func (encoder *PathEncoder) Dictionary() *PathDictionary {
+	return encoder.dictionary
+}
+
+func (encoder *PathEncoder) component(name string, delta *PathDictionary) uint32 {
+	if id, ok := encoder.components[name]; ok {
+		return id
+	}
+	id := uint32(len(encoder.components))
+	encoder.components[name] = id
+	delta.Components = append(delta.Components, name)
+	encoder.dictionary.Components = append(encoder.dictionary.Components, name)
+	return id
+}
+
+// Encode returns the node ids of the paths and appends new entries to delta.
+// Paths without a component are skipped, the root is not a file.
+func (encoder *PathEncoder) Encode(paths []string, delta *PathDictionary) []uint32 {
+	ids := make([]uint32, 0, len(paths))
+	for _, path := range paths {
+		var node uint32
+		for _, name := range strings.Split(path, "/") {
+			if name == "" {
+				continue
+			}
+			key := pathKey{parent: node, component: encoder.component(name, delta)}
+			id, ok := encoder.nodes[key]
+			if !ok {
+				// 0 is the root, so the first node gets 1
+				id = uint32(len(encoder.nodes)) + 1
+				encoder.nodes[key] = id
+				entry := &PathNode{
+					Parent:    key.parent,
+					Component: key.component,
+				}
+				delta.Nodes = append(delta.Nodes, entry)
+				encoder.dictionary.Nodes = append(encoder.dictionary.Nodes, entry)
+			}
+			node = id
+		}
+		if node == 0 {
+			continue
+		}
+		ids = append(ids, node)
+	}
+	return ids
+}
@@ -28,6 +28,7 @@ import (
 	"github.com/bubblesupreme/git-stories/git_info/config"
 
 	git "github.com/go-git/go-git/v5"
+	gitconfig "github.com/go-git/go-git/v5/config"
 	"github.com/go-git/go-git/v5/plumbing"
 	"github.com/go-git/go-git/v5/plumbing/object"
 	"github.com/go-git/go-git/v5/plumbing/transport/http"
@@ -38,10 +39,11 @@ type gitUser struct {
 	client         http.BasicAuth
 	owner          string
 	repository     string
+	source         config.Source
 	repositoryPath string
 }
 
-func CreategitUser(user config.User) *gitUser {
+func CreategitUser(user config.User, source config.Source) *gitUser {
 
 	return &gitUser{
 		client: http.BasicAuth{
@@ -50,15 +52,83 @@ func CreategitUser(user config.User) *gitUser {
 		},
 		owner:          user.Owner,
 		repository:     user.Repository,
+		source:         source,
 		repositoryPath: "",
 	}
 }
 
-func (gitUser *gitUser) CloneRepository(workingDirectory string) (string, error) {
+// PrepareRepository makes the repository of the source available and
+// returns its path: a local repository is opened in place, a mirror is
+// cloned once and fetched afterwards, anything else is cloned into the
+// working folder.
+func (gitUser *gitUser) PrepareRepository(workingDirectory string) (string, error) {
+	if gitUser.source.Path != "" {
+		return gitUser.openRepository(gitUser.source.Path)
+	}
+	if gitUser.source.Mirror != "" {
+		_, err := git.PlainOpen(gitUser.source.Mirror)
+		if err == git.ErrRepositoryNotExists {
+			return gitUser.cloneRepository(gitUser.source.Mirror)
+		}
+		if err != nil {
+			log.WithFields(log.Fields{
+				"mirror": gitUser.source.Mirror,
+			}).Error("Failed to open mirror.")
+			return "", err
+		}
+		return gitUser.fetchRepository(gitUser.source.Mirror)
+	}
+	return gitUser.cloneRepository(gitUser.getRepositoryPath(workingDirectory))
+}
+
+func (gitUser *gitUser) openRepository(repositoryPath string) (string, error) {
+	_, err := git.PlainOpen(repositoryPath)
+	if err != nil {
+		log.WithFields(log.Fields{
+			"repositoryPath": repositoryPath,
+		}).Error("Failed to open repository.")
+		return "", err
+	}
+
+	gitUser.repositoryPath = repositoryPath
+	return gitUser.repositoryPath, nil
+}
+
+// fetchRepository brings the branches of a mirror up to date, only the
+// objects it does not have yet are downloaded.
+func (gitUser *gitUser) fetchRepository(repositoryPath string) (string, error) {
+	rep, err := git.PlainOpen(repositoryPath)
+	if err != nil {
+		log.WithFields(log.Fields{
+			"repositoryPath": repositoryPath,
+		}).Error("Failed to open repository.")
+		return "", err
+	}
+
+	// the clone is bare, its branches are updated directly
+	err = rep.Fetch(&git.FetchOptions{
+		RemoteName: git.DefaultRemoteName,
+		RefSpecs:   []gitconfig.RefSpec{"+refs/heads/*:refs/heads/*"},
+		Auth:       &gitUser.client,
+		Progress:   os.Stdout,
+		Force:      true,
+	})
+	if err != nil && err != git.NoErrAlreadyUpToDate {
+		log.WithFields(log.Fields{
+			"repositoryPath": repositoryPath,
+		}).Error("Failed to fetch repository.")
+		return "", err
+	}
+
+	gitUser.repositoryPath = repositoryPath
+	return gitUser.repositoryPath, nil
+}
+
+func (gitUser *gitUser) cloneRepository(repositoryPath string) (string, error) {
 	url := gitUser.GetRepositoryHTTPSURL()
-	repositoryPath := gitUser.getRepositoryPath(workingDirectory)
 	var err error
-	_, err = git.PlainClone(repositoryPath, false, &git.CloneOptions{
+	// commits are read from the object store, no worktree is needed
+	_, err = git.PlainClone(repositoryPath, true, &git.CloneOptions{
 		Auth:     &gitUser.client,
 		URL:      url,
 		Progress: os.Stdout,
@@ -76,8 +146,11 @@ func (gitUser *gitUser) CloneRepository(workingDirectory string) (string, error)
 	return gitUser.repositoryPath, nil
 }
 
-func (gitUser *gitUser) GetCommits() ([]*object.Commit, error) {
-	commits := make([]*object.Commit, 0, 20)
+// GetCommitHashes returns the hashes of the history oldest first. Commits
+// are decoded one at a time while walking the log and only their hashes
+// are kept, they are resolved again when needed.
+func (gitUser *gitUser) GetCommitHashes() ([]plumbing.Hash, error) {
+	hashes := make([]plumbing.Hash, 0, 20)
 
 	rep, err := gitUser.getRepository()
 	if err != nil {
@@ -91,7 +164,7 @@ func (gitUser *gitUser) GetCommits() ([]*object.Commit, error) {
 	head, err := gitUser.getRepositoryHead()
 	if err != nil {
 		log.Error("Failed to get repository head.")
-		return commits, err
+		return hashes, err
 	}
 
 	cIter, err := rep.Log(&git.LogOptions{From: head.Hash()})
@@ -100,11 +173,12 @@ func (gitUser *gitUser) GetCommits() ([]*object.Commit, error) {
 			"repository": rep,
 		}).Error("Failed to get repository commits.")
 
-		return commits, err
+		return hashes, err
 	}
+	defer cIter.Close()
 
 	err = cIter.ForEach(func(c *object.Commit) error {
-		commits = append(commits, c)
+		hashes = append(hashes, c.Hash)
 
 		return nil
 	})
@@ -113,23 +187,14 @@ func (gitUser *gitUser) GetCommits() ([]*object.Commit, error) {
 			"cIter": cIter,
 		}).Error("Failed to iterate by commits.")
 
-		return commits, err
+		return hashes, err
 	}
 
-	return commits, nil
-}
-
-func (gitUser *gitUser) Checkout(commit *object.Commit) error {
-	workTree, err := gitUser.getRepositoryWorkTree()
-
-	if err != nil {
-		log.Error("Failed to get repository work tree.")
-		return err
+	// the log starts from the head
+	for i, j := 0, len(hashes)-1; i < j; i, j = i+1, j-1 {
+		hashes[i], hashes[j] = hashes[j], hashes[i]
 	}
-
-	return workTree.Checkout(&git.CheckoutOptions{
-		Hash: commit.Hash,
-	})
+	return hashes, nil
 }
 
 func (gitUser *gitUser) getRepository() (*git.Repository, error) {
@@ -140,6 +205,12 @@ func (gitUser *gitUser) getRepository() (*git.Repository, error) {
 	return git.PlainOpen(gitUser.repositoryPath)
 }
 
+// OpenRepository opens a new handle of the cloned repository. Handles are
+// not safe for concurrent use, every goroutine opens its own.
+func (gitUser *gitUser) OpenRepository() (*git.Repository, error) {
+	return gitUser.getRepository()
+}
+
 func (gitUser *gitUser) getRepositoryHead() (*plumbing.Reference, error) {
 	rep, err := gitUser.getRepository()
 	if err != nil {
@@ -153,17 +224,6 @@ func (gitUser *gitUser) getRepositoryHead() (*plumbing.Reference, error) {
 	return rep.Head()
 }
 
-func (gitUser *gitUser) getRepositoryWorkTree() (*git.Worktree, error) {
-	rep, err := gitUser.getRepository()
-
-	if err != nil {
-		log.Error("Failed to get repository head.")
-		return nil, err
-	}
-
-	return rep.Worktree()
-}
-
 func (gitUser *gitUser) GetRepositoryHTTPSURL() string {
 	return "https://github.com/" + gitUser.owner + "/" + gitUser.repository + ".git"
 }
@@ -172,52 +232,56 @@ func (gitUser *gitUser) getRepositoryPath(workingDirectory string) string {
 	return filepath.Join(workingDirectory, gitUser.repository)
 }
 
+// GetCommitInfo classifies the files of the commit against its first
+// parent. Only the trees are compared, no blob is read.
 func (gitUser *gitUser) GetCommitInfo(commit *object.Commit) ([]string, []string, []string, error) {
 	newFiles := make([]string, 0, 20)
 	deletedFiles := make([]string, 0, 20)
 	changedFiles := make([]string, 0, 20)
 
+	tree, err := commit.Tree()
+	if err != nil {
+		log.WithFields(log.Fields{
+			"commit": commit,
+		}).Error("Failed to get tree from a commit.")
+		return newFiles, deletedFiles, changedFiles, err
+	}
+
+	// the first commit is compared with an empty tree
+	var parentTree *object.Tree
 	parent, err := commit.Parent(0)
 	if err == object.ErrParentNotFound {
 		log.WithFields(log.Fields{
 			"commit": commit,
 		}).Info("First commit.")
-		tree, err := commit.Tree()
-		if err != nil {
-			log.WithFields(log.Fields{
-				"commit": commit,
-			}).Error("Failed to get tree from a commit.")
-			return newFiles, deletedFiles, changedFiles, err
-		}
-
-		tree.Files().ForEach(func(file *object.File) error {
-			newFiles = append(newFiles, file.Name)
-			return nil
-		})
-
-		return newFiles, deletedFiles, changedFiles, nil
+	} else if err == nil {
+		parentTree, err = parent.Tree()
+	}
+	if err != nil && err != object.ErrParentNotFound {
+		log.WithFields(log.Fields{
+			"commit": commit,
+		}).Error("Failed to get tree of the parent.")
+		return newFiles, deletedFiles, changedFiles, err
 	}
 
-	patch, err := parent.Patch(commit)
+	changes, err := object.DiffTree(parentTree, tree)
 	if err != nil {
 		log.WithFields(log.Fields{
 			"commit": commit,
-		}).Error("Failed to get a patch from a commit.")
-
+		}).Error("Failed to diff trees of a commit.")
 		return newFiles, deletedFiles, changedFiles, err
 	}
 
-	for _, filePatches := range patch.FilePatches() {
-		from, to := filePatches.Files()
-		if from == nil {
-			newFiles = append(newFiles, to.Path())
-		} else if to == nil {
-			deletedFiles = append(deletedFiles, from.Path())
-		} else if from.Path() != to.Path() {
-			newFiles = append(newFiles, to.Path())
-			deletedFiles = append(deletedFiles, from.Path())
+	for _, change := range changes {
+		if change.From.Name == "" {
+			newFiles = append(newFiles, change.To.Name)
+		} else if change.To.Name == "" {
+			deletedFiles = append(deletedFiles, change.From.Name)
+		} else if change.From.Name != change.To.Name {
+			newFiles = append(newFiles, change.To.Name)
+			deletedFiles = append(deletedFiles, change.From.Name)
 		} else {
-			changedFiles = append(changedFiles, from.Path())
+			changedFiles = append(changedFiles, change.From.Name)
 		}
 	}
 
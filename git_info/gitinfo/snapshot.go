@@ -0,0 +1,188 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+package gitinfo
+
+import (
+	"io"
+	"os"
+	"path/filepath"
+
+	"github.com/go-git/go-git/v5/plumbing"
+	"github.com/go-git/go-git/v5/plumbing/filemode"
+	"github.com/go-git/go-git/v5/plumbing/object"
+	log "github.com/sirupsen/logrus"
+)
+
+// FileChange is a file of the snapshot that was added, changed or removed
+// by an update. From is the zero hash for added files and To for removed
+// ones.
+type FileChange struct {
+	Name string
+	From plumbing.Hash
+	To   plumbing.Hash
+}
+
+// Snapshot mirrors the files of a commit that pass a filter into a
+// directory. Only the trees are compared with the previous commit, blobs
+// are read from the object store for the matching files that differ.
+type Snapshot struct {
+	directory string
+	matches   func(path string) bool
+	tree      *object.Tree
+}
+
+func CreateSnapshot(directory string, matches func(path string) bool) *Snapshot {
+	return &Snapshot{
+		directory: directory,
+		matches:   matches,
+	}
+}
+
+func (snapshot *Snapshot) Directory() string {
+	return snapshot.directory
+}
+
+// tracked reports whether the side of a change is a file of the snapshot.
+func (snapshot *Snapshot) tracked(entry *object.ChangeEntry) bool {
+	return entry.Name != "" && entry.TreeEntry.Mode.IsFile() &&
+		entry.TreeEntry.Mode != filemode.Symlink && snapshot.matches(entry.Name)
+}
+
+func (snapshot *Snapshot) writeFile(name string, file *object.File) error {
+	path := filepath.Join(snapshot.directory, filepath.FromSlash(name))
+	err := os.MkdirAll(filepath.Dir(path), 0777)
+	if err != nil {
+		log.WithFields(log.Fields{
+			"path": path,
+		}).Error("Failed to create folder.")
+		return err
+	}
+
+	reader, err := file.Reader()
+	if err != nil {
+		log.WithFields(log.Fields{
+			"file": name,
+		}).Error("Failed to read blob.")
+		return err
+	}
+	defer reader.Close()
+
+	output, err := os.Create(path)
+	if err != nil {
+		log.WithFields(log.Fields{
+			"path": path,
+		}).Error("Failed to create file.")
+		return err
+	}
+	_, err = io.Copy(output, reader)
+	if err == nil {
+		err = output.Close()
+	} else {
+		output.Close()
+	}
+	if err != nil {
+		log.WithFields(log.Fields{
+			"path": path,
+		}).Error("Failed to write file.")
+		return err
+	}
+	return nil
+}
+
+func (snapshot *Snapshot) removeFile(name string) error {
+	path := filepath.Join(snapshot.directory, filepath.FromSlash(name))
+	err := os.Remove(path)
+	if err != nil && !os.IsNotExist(err) {
+		log.WithFields(log.Fields{
+			"path": path,
+		}).Error("Failed to remove file.")
+		return err
+	}
+	return nil
+}
+
+// Update brings the directory to the state of the commit and returns the
+// files that differ from the previous one.
+func (snapshot *Snapshot) Update(commit *object.Commit) ([]FileChange, error) {
+	tree, err := commit.Tree()
+	if err != nil {
+		log.WithFields(log.Fields{
+			"commit": commit,
+		}).Error("Failed to get tree from a commit.")
+		return nil, err
+	}
+
+	// unchanged subtrees are skipped by their hashes
+	diff, err := object.DiffTree(snapshot.tree, tree)
+	if err != nil {
+		log.WithFields(log.Fields{
+			"commit": commit,
+		}).Error("Failed to diff trees of a commit.")
+		return nil, err
+	}
+
+	changes := make([]FileChange, 0, len(diff))
+	for _, change := range diff {
+		from := snapshot.tracked(&change.From)
+		to := snapshot.tracked(&change.To)
+		same := from && to && change.From.Name == change.To.Name
+		if same && change.From.TreeEntry.Hash == change.To.TreeEntry.Hash {
+			continue
+		}
+
+		if from && !same {
+			err = snapshot.removeFile(change.From.Name)
+			if err != nil {
+				return nil, err
+			}
+			changes = append(changes, FileChange{
+				Name: change.From.Name,
+				From: change.From.TreeEntry.Hash,
+			})
+		}
+		if !to {
+			continue
+		}
+
+		file, err := change.To.Tree.TreeEntryFile(&change.To.TreeEntry)
+		if err == nil {
+			err = snapshot.writeFile(change.To.Name, file)
+		}
+		if err != nil {
+			log.WithFields(log.Fields{
+				"commit": commit,
+				"file":   change.To.Name,
+			}).Error("Failed to write file of a commit.")
+			return nil, err
+		}
+		fileChange := FileChange{
+			Name: change.To.Name,
+			To:   change.To.TreeEntry.Hash,
+		}
+		if same {
+			fileChange.From = change.From.TreeEntry.Hash
+		}
+		changes = append(changes, fileChange)
+	}
+
+	snapshot.tree = tree
+	return changes, nil
+}
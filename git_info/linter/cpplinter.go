@@ -23,6 +23,7 @@ package linter
 import (
 	"bytes"
 	"errors"
+	"path/filepath"
 	"strconv"
 
 	log "github.com/sirupsen/logrus"
@@ -33,28 +34,62 @@ type CPPLinter struct {
 }
 
 func CreateCPPLinter(parameters []string) ILinter {
-	parameters = append(parameters, "./")
 	return &CPPLinter{
 		Linter{
 			name:           "cpplint",
 			parameters:     parameters,
 			resultTemplate: []byte("Total errors found: "),
 			inadmissible:   900,
+			extensions: []string{".c", ".cc", ".cpp", ".cxx", ".c++", ".cu",
+				".h", ".hh", ".hpp", ".hxx", ".h++", ".cuh"},
+			configFiles: []string{"CPPLINT.cfg"},
 		},
 	}
 }
 
-func (cppLint *CPPLinter) Run(directory string) ([]byte, error) {
-	return cppLint.baseLinter.Run(directory)
+func (cppLint *CPPLinter) GetName() string {
+	return cppLint.baseLinter.GetName()
 }
 
-func (cppLint *CPPLinter) ParseOutput(output []byte, err error) (int, error) {
-	if len(output) == 0 {
-		return 0, NoFilesError()
+func (cppLint *CPPLinter) GetParameters() []string {
+	return cppLint.baseLinter.GetParameters()
+}
+
+func (cppLint *CPPLinter) Run(directory string, files []string) ([]byte, error) {
+	return cppLint.baseLinter.Run(directory, files)
+}
+
+func (cppLint *CPPLinter) Matches(path string) bool {
+	return cppLint.baseLinter.Matches(path)
+}
+
+func (cppLint *CPPLinter) ConfigFiles() []string {
+	return cppLint.baseLinter.ConfigFiles()
+}
+
+func (cppLint *CPPLinter) Version() ([]byte, error) {
+	return cppLint.baseLinter.Version()
+}
+
+// ParseOutput counts the error lines of every file, they start with the
+// file name followed by ':' or, in the vs7 format, by '('. A run that
+// failed without output, e.g. because cpplint is not installed, is an
+// error rather than a clean result.
+func (cppLint *CPPLinter) ParseOutput(output []byte, err error, files []string) (map[string]int, error) {
+	if len(files) == 0 {
+		return nil, NoFilesError()
 	}
 
+	res := make(map[string]int, len(files))
 	if err == nil {
-		return 0, nil
+		return res, nil
+	}
+	if len(output) == 0 {
+		// cpplint reports every file it checks, it did not run
+		log.WithFields(log.Fields{
+			"err": err,
+		}).Error("Linter produced no output.")
+		return nil, err
 	}
 
 	ind := bytes.Index(output, cppLint.baseLinter.resultTemplate)
@@ -62,15 +97,38 @@ func (cppLint *CPPLinter) ParseOutput(output []byte, err error) (int, error) {
 		log.WithFields(log.Fields{
 			"resultTemplate": string(cppLint.baseLinter.resultTemplate),
 		}).Error("Failed to find result template.")
-		return -1, errors.New("output parsing failed")
+		return nil, errors.New("output parsing failed")
 	}
-	strRes := string(output[ind+len(cppLint.baseLinter.resultTemplate) : len(output)-1])
-	res, err := strconv.Atoi(strRes)
+	strTotal := string(bytes.TrimSpace(output[ind+len(cppLint.baseLinter.resultTemplate):]))
+	total, err := strconv.Atoi(strTotal)
 	if err != nil {
 		log.WithFields(log.Fields{
-			"strRes": strRes,
+			"strTotal": strTotal,
 		}).Error("Failed to convert string to int.")
-		return 0, err
+		return nil, err
+	}
+
+	names := make(map[string]string, len(files))
+	for _, file := range files {
+		names[filepath.FromSlash(file)] = file
+	}
+	var counted int
+	for _, line := range bytes.Split(output[:ind], []byte("\n")) {
+		end := bytes.IndexAny(line, ":(")
+		if end == -1 {
+			continue
+		}
+		if file, ok := names[string(line[:end])]; ok {
+			res[file]++
+			counted++
+		}
+	}
+	if counted != total {
+		log.WithFields(log.Fields{
+			"counted": counted,
+			"total":   total,
+		}).Error("Failed to attribute errors to files.")
+		return nil, errors.New("output parsing failed")
 	}
 	return res, nil
 }
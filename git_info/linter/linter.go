@@ -22,6 +22,7 @@ package linter
 
 import (
 	"errors"
+	"path/filepath"
 
 	"github.com/bubblesupreme/git-stories/git_info/utils"
 )
@@ -29,10 +30,22 @@ import (
 var noFilesError = errors.New("there are no files matching this linter")
 
 type ILinter interface {
-	ParseOutput(output []byte, err error) (int, error)
+	GetName() string
+	GetParameters() []string
+	// ParseOutput returns the number of errors in each of the files of a run.
+	ParseOutput(output []byte, err error, files []string) (map[string]int, error)
 	CalculateResult(errors int) (int, error)
-	Run(directory string) ([]byte, error)
+	// Run lints the files, given relative to directory.
+	Run(directory string, files []string) ([]byte, error)
 	CheckError(err error) error
+	// Matches reports whether the linter checks the file at path.
+	Matches(path string) bool
+	// ConfigFiles returns the names of the files that configure the linter
+	// for the files in their folder and below it.
+	ConfigFiles() []string
+	// Version identifies the installed linter, results of different
+	// versions may differ.
+	Version() ([]byte, error)
 }
 
 type Linter struct {
@@ -40,6 +53,8 @@ type Linter struct {
 	parameters     []string
 	resultTemplate []byte
 	inadmissible   int
+	extensions     []string
+	configFiles    []string
 }
 
 func (linter *Linter) GetName() string {
@@ -50,12 +65,44 @@ func (linter *Linter) GetParameters() []string {
 	return linter.parameters
 }
 
-func (linter *Linter) Run(directory string) ([]byte, error) {
+func (linter *Linter) Run(directory string, files []string) ([]byte, error) {
 	command := []string{linter.name}
 	command = append(command, linter.parameters...)
+	for _, file := range files {
+		command = append(command, filepath.FromSlash(file))
+	}
 	return utils.RunCommand(command, directory)
 }
 
+func (linter *Linter) Matches(path string) bool {
+	ext := filepath.Ext(path)
+	for _, extension := range linter.extensions {
+		if ext == extension {
+			return true
+		}
+	}
+	return false
+}
+
+func (linter *Linter) ConfigFiles() []string {
+	return linter.configFiles
+}
+
+func (linter *Linter) Version() ([]byte, error) {
+	return utils.RunCommand([]string{linter.name, "--version"}, "")
+}
+
+// IsConfigFile reports whether the file at path configures the linter.
+func IsConfigFile(lint ILinter, path string) bool {
+	name := filepath.Base(path)
+	for _, configFile := range lint.ConfigFiles() {
+		if name == configFile {
+			return true
+		}
+	}
+	return false
+}
+
 func NoFilesError() error {
 	return noFilesError
 }
@@ -22,6 +22,7 @@ package utils
 
 import (
 	"errors"
+	"io"
 	"os"
 	"os/exec"
 	"path/filepath"
@@ -142,3 +143,24 @@ func RunCommand(command []string, dir string) ([]byte, error) {
 	}
 	return cmd.CombinedOutput()
 }
+
+// StartCommand starts the command with its output going to ours and
+// returns a pipe to its standard input.
+func StartCommand(command []string, dir string) (*exec.Cmd, io.WriteCloser, error) {
+	cmd := exec.Command(command[0], command[1:]...)
+	if dir != "" {
+		cmd.Dir = dir
+	}
+	cmd.Stdout = os.Stdout
+	cmd.Stderr = os.Stderr
+	input, err := cmd.StdinPipe()
+	if err != nil {
+		return nil, nil, err
+	}
+	err = cmd.Start()
+	if err != nil {
+		input.Close()
+		return nil, nil, err
+	}
+	return cmd, input, nil
+}
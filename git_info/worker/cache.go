@@ -0,0 +1,145 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+package worker
+
+import (
+	"crypto/sha1"
+	"encoding/hex"
+	"io"
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"strconv"
+
+	"github.com/bubblesupreme/git-stories/git_info/linter"
+
+	log "github.com/sirupsen/logrus"
+)
+
+const (
+	cacheFolderName = "git-stories"
+)
+
+// LintCache keeps the number of errors a linter found in each blob at each
+// path under each set of config files across runs, in the user cache
+// folder rather than the working folder. Every linter name, version and
+// parameter list gets its own folder and every lint key a file named by
+// its hash. Entries are written to a temporary file and renamed into
+// place, so concurrent processes never see a partial entry.
+type LintCache struct {
+	directory string
+}
+
+func CreateLintCache(lint linter.ILinter) (*LintCache, error) {
+	cacheDirectory, err := os.UserCacheDir()
+	if err != nil {
+		log.Error("Failed to get user cache folder.")
+		return nil, err
+	}
+
+	version, err := lint.Version()
+	if err != nil {
+		log.WithFields(log.Fields{
+			"linter": lint.GetName(),
+		}).Error("Failed to get linter version.")
+		return nil, err
+	}
+
+	key := sha1.New()
+	io.WriteString(key, lint.GetName())
+	key.Write([]byte{0})
+	key.Write(version)
+	for _, parameter := range lint.GetParameters() {
+		key.Write([]byte{0})
+		io.WriteString(key, parameter)
+	}
+	directory := filepath.Join(cacheDirectory, cacheFolderName,
+		hex.EncodeToString(key.Sum(nil)))
+	err = os.MkdirAll(directory, 0777)
+	if err != nil {
+		log.WithFields(log.Fields{
+			"directory": directory,
+		}).Error("Failed to create folder.")
+		return nil, err
+	}
+
+	return &LintCache{
+		directory: directory,
+	}, nil
+}
+
+func (cache *LintCache) path(key lintKey) string {
+	digest := sha1.New()
+	digest.Write(key.hash[:])
+	digest.Write(key.config[:])
+	io.WriteString(digest, key.path)
+	entry := hex.EncodeToString(digest.Sum(nil))
+	return filepath.Join(cache.directory, entry[:2], entry[2:])
+}
+
+// Get returns the errors stored for the key, if any.
+func (cache *LintCache) Get(key lintKey) (int, bool) {
+	data, err := ioutil.ReadFile(cache.path(key))
+	if err != nil {
+		return 0, false
+	}
+	errors, err := strconv.Atoi(string(data))
+	if err != nil {
+		return 0, false
+	}
+	return errors, true
+}
+
+func (cache *LintCache) Put(key lintKey, errors int) error {
+	path := cache.path(key)
+	err := os.MkdirAll(filepath.Dir(path), 0777)
+	if err != nil {
+		log.WithFields(log.Fields{
+			"path": path,
+		}).Error("Failed to create folder.")
+		return err
+	}
+
+	file, err := ioutil.TempFile(filepath.Dir(path), "entry")
+	if err != nil {
+		log.WithFields(log.Fields{
+			"path": path,
+		}).Error("Failed to create file.")
+		return err
+	}
+	_, err = file.WriteString(strconv.Itoa(errors))
+	if err == nil {
+		err = file.Close()
+	} else {
+		file.Close()
+	}
+	if err == nil {
+		err = os.Rename(file.Name(), path)
+	}
+	if err != nil {
+		os.Remove(file.Name())
+		log.WithFields(log.Fields{
+			"path": path,
+		}).Error("Failed to write cache entry.")
+		return err
+	}
+	return nil
+}
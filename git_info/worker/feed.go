@@ -0,0 +1,90 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+package worker
+
+import (
+	"github.com/bubblesupreme/git-stories/git_info/config"
+
+	log "github.com/sirupsen/logrus"
+)
+
+// streamFeed writes commits to a streaming renderer from its own
+// goroutine. The renderer reads only as fast as it plays, so the commits
+// wait in the queue and ingestion never waits for the renderer.
+type streamFeed struct {
+	stream *config.StreamWriter
+	queue  chan *config.CommitInfo
+	done   chan struct{}
+}
+
+func createStreamFeed(stream *config.StreamWriter) *streamFeed {
+	return &streamFeed{
+		stream: stream,
+	}
+}
+
+// Start writes the history, if there is one, and then up to capacity
+// commits given to Send.
+func (feed *streamFeed) Start(history *config.History, capacity int) {
+	feed.queue = make(chan *config.CommitInfo, capacity)
+	feed.done = make(chan struct{})
+	go func() {
+		defer close(feed.done)
+		stream := feed.stream
+		if history != nil {
+			err := stream.CopyHistory(history)
+			history.Close()
+			if err != nil {
+				log.Warning("Failed to stream the kept history, streaming stops.")
+				stream = nil
+			}
+		}
+		for commit := range feed.queue {
+			if stream == nil {
+				continue
+			}
+			err := stream.Write(commit)
+			if err != nil {
+				// the renderer is gone, the file is still written
+				log.Warning("Failed to stream commit, streaming stops.")
+				stream = nil
+			}
+		}
+	}()
+}
+
+func (feed *streamFeed) Send(commit *config.CommitInfo) {
+	feed.queue <- commit
+}
+
+// Close tells that there are no more commits to send.
+func (feed *streamFeed) Close() {
+	if feed.queue != nil {
+		close(feed.queue)
+	}
+}
+
+// Wait returns once everything sent is written to the renderer.
+func (feed *streamFeed) Wait() {
+	if feed.done != nil {
+		<-feed.done
+	}
+}
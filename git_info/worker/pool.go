@@ -0,0 +1,256 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+package worker
+
+import (
+	"os"
+	"path/filepath"
+	"runtime"
+	"strconv"
+	"sync"
+	"sync/atomic"
+
+	"github.com/bubblesupreme/git-stories/git_info/gitinfo"
+	"github.com/bubblesupreme/git-stories/git_info/linter"
+	"github.com/bubblesupreme/git-stories/git_info/utils"
+
+	git "github.com/go-git/go-git/v5"
+	"github.com/go-git/go-git/v5/plumbing"
+	"github.com/go-git/go-git/v5/plumbing/object"
+	log "github.com/sirupsen/logrus"
+)
+
+// minRangeCommits keeps ranges long enough to pay for linting their first
+// commit as a whole.
+const minRangeCommits = 64
+
+type commitSource interface {
+	OpenRepository() (*git.Repository, error)
+	GetCommitInfo(commit *object.Commit) ([]string, []string, []string, error)
+}
+
+// commitResult is what a pool worker finds out about a commit.
+type commitResult struct {
+	newFiles     []string
+	deletedFiles []string
+	changedFiles []string
+	errors       int
+	timestamp    int64
+}
+
+// commitPool processes a history in contiguous ranges of commits, one per
+// goroutine. Every goroutine has its own repository handle, snapshot and
+// tallies; the first commit of a range is linted as a whole, the following
+// ones incrementally. Lint results are shared through the caches. The
+// linters of a commit run side by side, and processes bounds the number of
+// linter processes of the whole pool.
+type commitPool struct {
+	source    commitSource
+	linters   []linter.ILinter
+	caches    []*LintCache
+	directory string
+	processes chan struct{}
+	failed    int32
+}
+
+// matches reports whether a linter checks the file at path or reads its
+// configuration from it.
+func (pool *commitPool) matches(path string) bool {
+	for _, lint := range pool.linters {
+		if lint.Matches(path) || linter.IsConfigFile(lint, path) {
+			return true
+		}
+	}
+	return false
+}
+
+// processRange fills results[start:end] from the commits in the same
+// positions, using the snapshot folder with the given number, and closes
+// the done channel of every commit it has finished.
+func (pool *commitPool) processRange(number int, commits []plumbing.Hash, results []commitResult, done []chan struct{}, start, end int) error {
+	rep, err := pool.source.OpenRepository()
+	if err != nil {
+		log.Error("Failed to open repository.")
+		return err
+	}
+
+	// linters only see the files they check, written from the object store
+	snapshotPath := filepath.Join(pool.directory, strconv.Itoa(number))
+	snapshot := gitinfo.CreateSnapshot(snapshotPath, pool.matches)
+	err = utils.CreateFolder(snapshotPath, true)
+	if err != nil {
+		log.WithFields(log.Fields{
+			"snapshotPath": snapshotPath,
+		}).Error("Failed to create folder.")
+		return err
+	}
+	// linters that look for the repository root, like cpplint for header
+	// guards, find it here whatever the number of the snapshot
+	err = os.Mkdir(filepath.Join(snapshotPath, ".git"), 0777)
+	if err != nil {
+		log.WithFields(log.Fields{
+			"snapshotPath": snapshotPath,
+		}).Error("Failed to mark repository root.")
+		return err
+	}
+
+	tallies := make([]*Tally, 0, len(pool.linters))
+	for i, lint := range pool.linters {
+		tallies = append(tallies, CreateTally(lint, pool.caches[i], pool.processes))
+	}
+
+	for i := start; i < end && atomic.LoadInt32(&pool.failed) == 0; i++ {
+		commit, err := rep.CommitObject(commits[i])
+		if err != nil {
+			log.WithFields(log.Fields{
+				"commit": commits[i],
+			}).Error("Failed to get commit.")
+			return err
+		}
+
+		changes, err := snapshot.Update(commit)
+		if err != nil {
+			log.WithFields(log.Fields{
+				"commit": commit,
+			}).Error("Failed to update snapshot.")
+			return err
+		}
+
+		errs := make([]error, len(tallies))
+		var wait sync.WaitGroup
+		for number, tally := range tallies {
+			wait.Add(1)
+			go func(number int, tally *Tally) {
+				defer wait.Done()
+				errs[number] = tally.Update(snapshot.Directory(), changes)
+			}(number, tally)
+		}
+		wait.Wait()
+
+		var errors int
+		for number, tally := range tallies {
+			if errs[number] != nil {
+				log.WithFields(log.Fields{
+					"commit": commit,
+				}).Error("Failed to lint commit.")
+				return errs[number]
+			}
+
+			res, err := tally.Result()
+			if err != nil {
+				log.Error("Failed to calculate result.")
+				return err
+			}
+			errors += res
+		}
+
+		newFiles, deletedFiles, changedFiles, err := pool.source.GetCommitInfo(commit)
+		if err != nil {
+			log.WithFields(log.Fields{
+				"commit": commit,
+			}).Error("Failed to get commit information.")
+			return err
+		}
+		results[i] = commitResult{
+			newFiles:     newFiles,
+			deletedFiles: deletedFiles,
+			changedFiles: changedFiles,
+			errors:       errors,
+			timestamp:    commit.Committer.When.Unix(),
+		}
+		close(done[i])
+	}
+	return nil
+}
+
+// Process hands the results of the commits, given in the order they are
+// written, to emit in the same order as soon as they are ready. The
+// commits are processed with up to one goroutine per core.
+func (pool *commitPool) Process(commits []plumbing.Hash, emit func(index int, result commitResult) error) error {
+	err := utils.CreateFolder(pool.directory, true)
+	if err != nil {
+		log.WithFields(log.Fields{
+			"directory": pool.directory,
+		}).Error("Failed to create folder.")
+		return err
+	}
+
+	workers := runtime.NumCPU()
+	if workers > len(commits)/minRangeCommits {
+		workers = len(commits) / minRangeCommits
+	}
+	if workers < 1 {
+		workers = 1
+	}
+	pool.processes = make(chan struct{}, runtime.NumCPU())
+	results := make([]commitResult, len(commits))
+	done := make([]chan struct{}, len(commits))
+	for i := range done {
+		done[i] = make(chan struct{})
+	}
+	failed := make(chan struct{})
+	var fail sync.Once
+	stop := func() {
+		fail.Do(func() {
+			atomic.StoreInt32(&pool.failed, 1)
+			close(failed)
+		})
+	}
+
+	errs := make([]error, workers)
+	var wait sync.WaitGroup
+	for number := 0; number < workers; number++ {
+		wait.Add(1)
+		go func(number int) {
+			defer wait.Done()
+			start := len(commits) * number / workers
+			end := len(commits) * (number + 1) / workers
+			errs[number] = pool.processRange(number, commits, results, done, start, end)
+			if errs[number] != nil {
+				stop()
+			}
+		}(number)
+	}
+
+	for i := range commits {
+		select {
+		case <-done[i]:
+			err = emit(i, results[i])
+			// the result is not needed any more
+			results[i] = commitResult{}
+		case <-failed:
+		}
+		if err != nil {
+			stop()
+		}
+		if atomic.LoadInt32(&pool.failed) != 0 {
+			break
+		}
+	}
+	wait.Wait()
+
+	for _, rangeErr := range errs {
+		if rangeErr != nil {
+			return rangeErr
+		}
+	}
+	return err
+}
@@ -0,0 +1,217 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+package worker
+
+import (
+	"crypto/sha1"
+	"path"
+	"sort"
+	"strings"
+
+	"github.com/bubblesupreme/git-stories/git_info/gitinfo"
+	"github.com/bubblesupreme/git-stories/git_info/linter"
+
+	"github.com/go-git/go-git/v5/plumbing"
+	log "github.com/sirupsen/logrus"
+)
+
+// lintBatchSize bounds the number of files passed to one linter run.
+const lintBatchSize = 256
+
+// lintKey identifies a lint result. It depends on the path of a file as
+// well as on its content, e.g. cpplint derives header guards from it, and
+// on the config files that govern it.
+type lintKey struct {
+	path   string
+	hash   plumbing.Hash
+	config plumbing.Hash
+}
+
+// Tally keeps the number of errors a linter found in every blob at every
+// path it has seen and their sum over the files of the current snapshot.
+// Only files that were never seen before are linted, so the cost of a
+// commit follows its churn rather than the size of the repository. A
+// changed config file brings back every file in its folder and below it.
+// Results are looked up in and stored to the cache, if there is one. Every
+// linter run holds a slot of processes.
+type Tally struct {
+	lint      linter.ILinter
+	cache     *LintCache
+	processes chan struct{}
+	errors    map[lintKey]int
+	// the key of every checked file and the blob of every config file of
+	// the snapshot
+	files   map[string]lintKey
+	configs map[string]plumbing.Hash
+	total   int
+}
+
+func CreateTally(lint linter.ILinter, cache *LintCache, processes chan struct{}) *Tally {
+	return &Tally{
+		lint:      lint,
+		cache:     cache,
+		processes: processes,
+		errors:    make(map[lintKey]int),
+		files:     make(map[string]lintKey),
+		configs:   make(map[string]plumbing.Hash),
+	}
+}
+
+// configHash combines the blobs of the config files in the folder of the
+// file at name and in every folder above it, it is zero if there are none.
+func (tally *Tally) configHash(name string) plumbing.Hash {
+	var res plumbing.Hash
+	if len(tally.configs) == 0 {
+		return res
+	}
+	digest := sha1.New()
+	for folder := path.Dir(name); ; folder = path.Dir(folder) {
+		for _, configFile := range tally.lint.ConfigFiles() {
+			configPath := path.Join(folder, configFile)
+			if hash, ok := tally.configs[configPath]; ok {
+				digest.Write([]byte(configPath))
+				digest.Write(hash[:])
+			}
+		}
+		if folder == "." {
+			break
+		}
+	}
+	copy(res[:], digest.Sum(nil))
+	return res
+}
+
+func (tally *Tally) lintFiles(directory string, keys []lintKey) error {
+	files := make([]string, len(keys))
+	for i, key := range keys {
+		files[i] = key.path
+	}
+	tally.processes <- struct{}{}
+	output, err := tally.lint.Run(directory, files)
+	<-tally.processes
+	// only parsed results are kept, a failed run must not reach the cache
+	counts, err := tally.lint.ParseOutput(output, err, files)
+	if err != nil {
+		log.WithFields(log.Fields{
+			"output": string(output),
+		}).Error("Failed to parse output.")
+		return err
+	}
+
+	for _, key := range keys {
+		tally.errors[key] = counts[key.path]
+		if tally.cache != nil {
+			err = tally.cache.Put(key, counts[key.path])
+			if err != nil {
+				log.WithFields(log.Fields{
+					"file": key.path,
+				}).Warning("Failed to cache lint result.")
+			}
+		}
+	}
+	return nil
+}
+
+// Update lints the new blobs among the changes of the snapshot in
+// directory, and the files under changed config files, and moves the total
+// from the previous snapshot to this one.
+func (tally *Tally) Update(directory string, changes []gitinfo.FileChange) error {
+	// the new blob of every file whose key may change, zero if it is gone
+	stale := make(map[string]plumbing.Hash, len(changes))
+	var folders []string
+	for _, change := range changes {
+		if linter.IsConfigFile(tally.lint, change.Name) {
+			if change.To.IsZero() {
+				delete(tally.configs, change.Name)
+			} else {
+				tally.configs[change.Name] = change.To
+			}
+			folders = append(folders, path.Dir(change.Name))
+		} else if tally.lint.Matches(change.Name) {
+			stale[change.Name] = change.To
+		}
+	}
+	for name, key := range tally.files {
+		if _, ok := stale[name]; ok {
+			continue
+		}
+		for _, folder := range folders {
+			if folder == "." || strings.HasPrefix(name, folder+"/") {
+				stale[name] = key.hash
+				break
+			}
+		}
+	}
+
+	keys := make(map[string]lintKey, len(stale))
+	missing := make([]lintKey, 0, len(stale))
+	for name, hash := range stale {
+		if hash.IsZero() {
+			continue
+		}
+		key := lintKey{name, hash, tally.configHash(name)}
+		keys[name] = key
+		if _, ok := tally.errors[key]; ok {
+			continue
+		}
+		if tally.cache != nil {
+			if errors, ok := tally.cache.Get(key); ok {
+				tally.errors[key] = errors
+				continue
+			}
+		}
+		missing = append(missing, key)
+	}
+	sort.Slice(missing, func(i, j int) bool {
+		return missing[i].path < missing[j].path
+	})
+
+	for start := 0; start < len(missing); start += lintBatchSize {
+		end := start + lintBatchSize
+		if end > len(missing) {
+			end = len(missing)
+		}
+		err := tally.lintFiles(directory, missing[start:end])
+		if err != nil {
+			log.WithFields(log.Fields{
+				"directory": directory,
+			}).Error("Failed to lint files.")
+			return err
+		}
+	}
+
+	for name := range stale {
+		if key, ok := tally.files[name]; ok {
+			tally.total -= tally.errors[key]
+			delete(tally.files, name)
+		}
+		if key, ok := keys[name]; ok {
+			tally.total += tally.errors[key]
+			tally.files[name] = key
+		}
+	}
+	return nil
+}
+
+// Result is the score of the linter for the current snapshot.
+func (tally *Tally) Result() (int, error) {
+	return tally.lint.CalculateResult(tally.total)
+}
@@ -21,18 +21,21 @@
 package worker
 
 import (
+	"io"
+	"os"
+	"os/exec"
 	"path/filepath"
 
 	"github.com/bubblesupreme/git-stories/git_info/config"
 	"github.com/bubblesupreme/git-stories/git_info/gitinfo"
-	"github.com/bubblesupreme/git-stories/git_info/linter"
 	"github.com/bubblesupreme/git-stories/git_info/utils"
 
 	log "github.com/sirupsen/logrus"
 )
 
 const (
-	workingFolderName = "Temp"
+	workingFolderName  = "Temp"
+	snapshotFolderName = "snapshot"
 )
 
 func getCloneRepositoryString(url string) string {
@@ -57,14 +60,10 @@ func CreateWorker() (*Worker, error) {
 	}, nil
 }
 
-func (worker *Worker) createResultConfig(configPath string) (string, error) {
-	userConfig, err := config.ParseJsonConfig(configPath)
-	if err != nil {
-		log.WithFields(log.Fields{
-			"configPath": configPath,
-		}).Error("Failed to parse config.")
-		return "", err
-	}
+// createResultConfig writes the .gs file and, if feed is not nil, sends
+// every commit to it as soon as it is known. The feed is closed once all
+// commits are sent.
+func (worker *Worker) createResultConfig(userConfig *config.Config, feed *streamFeed) (string, error) {
 	user := userConfig.GetUser()
 	linters, err := userConfig.GetLinters()
 	if err != nil {
@@ -74,86 +73,114 @@ func (worker *Worker) createResultConfig(configPath string) (string, error) {
 
 		return "", err
 	}
-	gitUser := gitinfo.CreategitUser(user)
+	gitUser := gitinfo.CreategitUser(user, userConfig.GetSource())
 	url := gitUser.GetRepositoryHTTPSURL()
 
-	_, err = gitUser.CloneRepository(worker.workingFolderFullPath)
+	_, err = gitUser.PrepareRepository(worker.workingFolderFullPath)
 	if err != nil {
 		log.WithFields(log.Fields{
 			"url": url,
-		}).Error("Failed to clone repository.")
+		}).Error("Failed to prepare repository.")
 
 		return "", err
 	}
 
-	commits, err := gitUser.GetCommits()
+	commits, err := gitUser.GetCommitHashes()
 	if err != nil {
 		log.Error("Failed to get commits.")
 		return "", err
 	}
-	// fmt.Println(commits)
 
-	outConfig := config.OutConfig{
-		Commits: make([]*config.CommitInfo, 0, len(commits)),
+	// commits already in the kept output are skipped
+	output := userConfig.GetOutput()
+	resultFile := filepath.Join(worker.workingFolderFullPath, "output.gs")
+	encoder := config.CreatePathEncoder()
+	appending := false
+	// a commit's Errors accumulates the results of every commit up to it
+	var commonRes int
+	if output.Path != "" {
+		resultFile = output.Path
+		count, last, dictionary, err := config.ReadHistory(resultFile)
+		if err == nil && count > 0 && count <= uint64(len(commits)) &&
+			commits[count-1].String() == last.GetHash() {
+			commits = commits[count:]
+			encoder = config.CreatePathEncoderFrom(dictionary)
+			commonRes = int(last.GetErrors())
+			appending = true
+		} else if err == nil || !os.IsNotExist(err) {
+			log.WithFields(log.Fields{
+				"resultFile": resultFile,
+			}).Warning("Output does not match the history, so rewrite it.")
+		}
 	}
 
-	var commonRes int
-	// reversed range
-	for i := len(commits) - 1; i >= 0; i-- {
-		err = gitUser.Checkout(commits[i])
+	pool := &commitPool{
+		source:    gitUser,
+		linters:   linters,
+		caches:    make([]*LintCache, len(linters)),
+		directory: filepath.Join(worker.workingFolderFullPath, snapshotFolderName),
+	}
+	for i, lint := range linters {
+		pool.caches[i], err = CreateLintCache(lint)
 		if err != nil {
 			log.WithFields(log.Fields{
-				"commit": commits[i],
-			}).Error("Failed to checkout.")
-			return "", err
+				"linter": lint.GetName(),
+			}).Warning("Failed to open lint cache, linting without it.")
 		}
-
-		for _, lint := range linters {
-			output, err := lint.Run(worker.workingFolderFullPath)
-			// fmt.Println(string(output))
-			// fmt.Println(err)
-
-			numErrors, err := lint.ParseOutput(output, err)
-
-			if err != nil && err != linter.NoFilesError() {
-				log.WithFields(log.Fields{
-					"output": string(output),
-				}).Error("Failed to parse output.")
-				return "", err
+	}
+	if feed != nil {
+		// the history is opened before anything is appended to it
+		var history *config.History
+		if appending {
+			history, err = config.OpenHistory(resultFile)
+			if err != nil {
+				log.Warning("Failed to open the kept history, streaming stops.")
+				feed = nil
 			}
+		}
+		if feed != nil {
+			feed.Start(history, len(commits))
+			defer feed.Close()
+		}
+	}
 
-			var res int
-			if err == linter.NoFilesError() {
-				res = 0
-			} else {
-				res, err = lint.CalculateResult(numErrors)
-				if err != nil {
-					log.Error("Failed to calculate result.")
-					return "", err
-				}
-			}
-			commonRes += res
+	outConfig := config.OutConfig{
+		Commits: make([]*config.CommitInfo, 0, len(commits)),
+	}
+	err = pool.Process(commits, func(i int, result commitResult) error {
+		commonRes += result.errors
+		// paths are written as ids, the dictionary carries new components
+		dictionary := &config.PathDictionary{}
+		commitInfo := &config.CommitInfo{
+			Hash:           commits[i].String(),
+			NewFileIds:     encoder.Encode(result.newFiles, dictionary),
+			DeletedFileIds: encoder.Encode(result.deletedFiles, dictionary),
+			ChangedFileIds: encoder.Encode(result.changedFiles, dictionary),
+			Errors:         int32(commonRes),
+			Timestamp:      result.timestamp,
+		}
+		if len(dictionary.Nodes) > 0 {
+			commitInfo.Dictionary = dictionary
 		}
+		outConfig.Commits = append(outConfig.Commits, commitInfo)
 
-		// fmt.Println(commonRes)
-		newFiles, deletedFiles, changedFiles, err := gitUser.GetCommitInfo(commits[i])
-		if err != nil {
-			log.WithFields(log.Fields{
-				"commit": commits[i],
-			}).Error("Failed to get commit information.")
-			return "", err
+		if feed != nil {
+			feed.Send(commitInfo)
 		}
-		outConfig.Commits = append(outConfig.Commits, &config.CommitInfo{
-			Hash:         commits[i].Hash.String(),
-			NewFiles:     newFiles,
-			DeletedFiles: deletedFiles,
-			ChangedFiles: changedFiles,
-			Errors:       int32(commonRes),
-		})
+		return nil
+	})
+	if err != nil {
+		log.Error("Failed to process commits.")
+		return "", err
 	}
 
-	resultFile := filepath.Join(worker.workingFolderFullPath, "output.gs")
-	err = outConfig.WriteResults(resultFile)
+	outConfig.Dictionary = encoder.Dictionary()
+
+	if appending {
+		err = config.AppendResults(resultFile, outConfig.Commits, outConfig.Dictionary)
+	} else {
+		err = outConfig.WriteResults(resultFile, output.Compressed)
+	}
 	if err != nil {
 		log.WithFields(log.Fields{
 			"outConfig": outConfig,
@@ -174,22 +201,70 @@ func (worker *Worker) Work(configPath string) error {
 		return err
 	}
 
-	resultFile, err := worker.createResultConfig(configPath)
+	userConfig, err := config.ParseJsonConfig(configPath)
 	if err != nil {
-		log.Error("Failed to create result config.")
+		log.WithFields(log.Fields{
+			"configPath": configPath,
+		}).Error("Failed to parse config.")
 		return err
 	}
 
-	command := []string{"./gs_rendering", resultFile}
-	output, err := utils.RunCommand(command, "")
+	// a streaming renderer starts first and reads the commits from a pipe,
+	// it blocks the writes while it is not ready for more
+	var renderer *exec.Cmd
+	var input io.WriteCloser
+	var feed *streamFeed
+	if userConfig.GetOutput().Stream {
+		command := []string{"./gs_rendering", "-"}
+		renderer, input, err = utils.StartCommand(command, "")
+		if err != nil {
+			log.WithFields(log.Fields{
+				"command": command,
+			}).Error("Failed to start command.")
+			return err
+		}
+		stream, err := config.CreateStreamWriter(input)
+		if err != nil {
+			log.Warning("Failed to start stream.")
+		} else {
+			feed = createStreamFeed(stream)
+		}
+	}
+
+	resultFile, err := worker.createResultConfig(userConfig, feed)
+	if renderer != nil {
+		if err != nil {
+			// the rest of the stream never comes, the renderer must not
+			// outlive the worker
+			renderer.Process.Kill()
+		} else if feed != nil {
+			feed.Wait()
+		}
+		// the renderer sees the end of the stream and keeps running
+		input.Close()
+		waitErr := renderer.Wait()
+		if err == nil && waitErr != nil {
+			log.Error("Failed to run renderer.")
+			return waitErr
+		}
+	}
 	if err != nil {
-		log.WithFields(log.Fields{
-			"command": command,
-			"output":  string(output),
-		}).Error("Failed to run command.")
+		log.Error("Failed to create result config.")
 		return err
 	}
 
+	if renderer == nil {
+		command := []string{"./gs_rendering", resultFile}
+		output, err := utils.RunCommand(command, "")
+		if err != nil {
+			log.WithFields(log.Fields{
+				"command": command,
+				"output":  string(output),
+			}).Error("Failed to run command.")
+			return err
+		}
+	}
+
 	err = utils.RemoveFolder(worker.workingFolderFullPath, true)
 	if err != nil {
 		log.WithFields(log.Fields{
@@ -0,0 +1,90 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "arena.h"
+
+#include <stdlib.h>
+
+#include "utils.h"
+
+static GS_ArenaBlock *createBlock(size_t size, GS_ArenaBlock *next) {
+  GS_ArenaBlock *block = malloc(sizeof(GS_ArenaBlock) + size);
+  GS_NOT_NULL(block)
+  block->next = next;
+  block->size = size;
+  block->used = 0;
+  return block;
+}
+
+static void *arenaAlloc(void *data, size_t size) {
+  return GS_ArenaAlloc(data, size);
+}
+
+static void arenaFree(void *data, void *pointer) {}
+
+GS_Status *GS_CreateArena(size_t block_size, GS_Arena **out) {
+  GS_Arena *arena = malloc(sizeof(GS_Arena));
+  GS_NOT_NULL(arena)
+  arena->block_size = block_size;
+  arena->head = createBlock(block_size, NULL);
+  arena->allocator.alloc = arenaAlloc;
+  arena->allocator.free = arenaFree;
+  arena->allocator.allocator_data = arena;
+  *out = arena;
+  return GS_Ok();
+}
+
+static void freeBlocks(GS_ArenaBlock *block) {
+  while (block) {
+    GS_ArenaBlock *next = block->next;
+    free(block);
+    block = next;
+  }
+}
+
+void GS_DestroyArena(GS_Arena *arena) {
+  freeBlocks(arena->head);
+  free(arena);
+}
+
+void *GS_ArenaAlloc(GS_Arena *arena, size_t size) {
+  size_t align = alignof(max_align_t);
+  size = (size + align - 1) & ~(align - 1);
+  GS_ArenaBlock *head = arena->head;
+  if (head->size - head->used < size) {
+    size_t block_size = size > arena->block_size ? size : arena->block_size;
+    head = arena->head = createBlock(block_size, head);
+  }
+  void *res = head->data + head->used;
+  head->used += size;
+  return res;
+}
+
+void GS_ResetArena(GS_Arena *arena) {
+  if (arena->head->next) {
+    size_t total = 0;
+    for (GS_ArenaBlock *b = arena->head; b; b = b->next) {
+      total += b->size;
+    }
+    freeBlocks(arena->head);
+    arena->head = createBlock(total, NULL);
+  }
+  arena->head->used = 0;
+}
@@ -0,0 +1,53 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "protobuf-c/protobuf-c.h"
+#include "status.h"
+
+typedef struct GS_ArenaBlock_ {
+  struct GS_ArenaBlock_ *next;
+  size_t size;
+  size_t used;
+  alignas(max_align_t) uint8_t data[];
+} GS_ArenaBlock;
+
+// Bump allocator: allocations are never freed one by one, the whole arena
+// is reset or destroyed at once. The allocator field lets protobuf-c
+// unpack messages into it.
+typedef struct {
+  GS_ArenaBlock *head;
+  size_t block_size;
+  ProtobufCAllocator allocator;
+} GS_Arena;
+
+GS_Status *GS_CreateArena(size_t block_size, GS_Arena **out);
+
+void GS_DestroyArena(GS_Arena *arena);
+
+void *GS_ArenaAlloc(GS_Arena *arena, size_t size);
+
+// Drops every allocation. Memory is kept as a single block big enough for
+// everything allocated since the previous reset.
+void GS_ResetArena(GS_Arena *arena);
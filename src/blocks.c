@@ -0,0 +1,196 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "blocks.h"
+
+#include <stdlib.h>
+#include <zlib.h>
+
+static uint64_t storedSize(GS_BlockReader *reader, uint64_t block) {
+  return GS_ReadLittleEndian(
+      reader->entries + block * GS_BLOCK_ENTRY_SIZE + 8, 4);
+}
+
+static uint64_t rawSize(GS_BlockReader *reader, uint64_t block) {
+  return GS_ReadLittleEndian(
+      reader->entries + block * GS_BLOCK_ENTRY_SIZE + 12, 4);
+}
+
+static uint8_t *storedData(GS_BlockReader *reader, uint64_t block) {
+  return reader->data +
+         GS_ReadLittleEndian(reader->entries + block * GS_BLOCK_ENTRY_SIZE, 8);
+}
+
+static bool isCompressed(GS_BlockReader *reader, uint64_t block) {
+  return storedSize(reader, block) != rawSize(reader, block);
+}
+
+static GS_BlockSlot *findSlot(GS_BlockReader *reader, uint64_t block) {
+  for (size_t i = 0; i < GS_PREFETCH_BLOCKS; i++) {
+    if (reader->slots[i].block == (int64_t)block) {
+      return &reader->slots[i];
+    }
+  }
+  return NULL;
+}
+
+static bool isWanted(GS_BlockReader *reader, int64_t block) {
+  return block >= (int64_t)reader->wanted &&
+         block < (int64_t)(reader->wanted + GS_PREFETCH_BLOCKS);
+}
+
+// Picks the first wanted block that is not inflated yet and a slot holding
+// a block that is not wanted any more. Called under mutex.
+static GS_BlockSlot *nextJob(GS_BlockReader *reader, uint64_t *block) {
+  for (uint64_t i = reader->wanted;
+       i < reader->count && i < reader->wanted + GS_PREFETCH_BLOCKS; i++) {
+    if (!isCompressed(reader, i) || findSlot(reader, i)) {
+      continue;
+    }
+    for (size_t j = 0; j < GS_PREFETCH_BLOCKS; j++) {
+      GS_BlockSlot *slot = &reader->slots[j];
+      if (!isWanted(reader, slot->block)) {
+        *block = i;
+        return slot;
+      }
+    }
+  }
+  return NULL;
+}
+
+static bool inflateBlock(GS_BlockReader *reader, uint64_t block,
+                         GS_BlockSlot *slot) {
+  uLongf size = rawSize(reader, block);
+  if (slot->capacity < size) {
+    free(slot->data);
+    slot->data = malloc(size);
+    GS_NOT_NULL(slot->data)
+    slot->capacity = size;
+  }
+  return uncompress(slot->data, &size, storedData(reader, block),
+                    storedSize(reader, block)) == Z_OK &&
+         size == rawSize(reader, block);
+}
+
+static int blockThread(void *data) {
+  GS_BlockReader *reader = data;
+  SDL_LockMutex(reader->mutex);
+  while (reader->working) {
+    uint64_t block;
+    GS_BlockSlot *slot = nextJob(reader, &block);
+    if (!slot) {
+      SDL_CondWait(reader->changed, reader->mutex);
+      continue;
+    }
+    slot->block = block;
+    slot->ready = false;
+    // the slot is not touched by readers until it is ready
+    SDL_UnlockMutex(reader->mutex);
+    bool inflated = inflateBlock(reader, block, slot);
+    SDL_LockMutex(reader->mutex);
+    slot->ready = true;
+    slot->corrupted = !inflated;
+    SDL_CondBroadcast(reader->changed);
+  }
+  SDL_UnlockMutex(reader->mutex);
+  return 0;
+}
+
+GS_Status *GS_CreateBlockReader(char *path, uint8_t *data, size_t size,
+                                uint8_t *entries, uint64_t count,
+                                GS_BlockReader **out) {
+  for (uint64_t i = 0; i < count; i++) {
+    uint8_t *entry = entries + i * GS_BLOCK_ENTRY_SIZE;
+    uint64_t offset = GS_ReadLittleEndian(entry, 8);
+    uint64_t stored = GS_ReadLittleEndian(entry + 8, 4);
+    if (offset > size || stored > size - offset ||
+        stored > GS_ReadLittleEndian(entry + 12, 4)) {
+      return GS_CorruptedData(path);
+    }
+  }
+
+  GS_BlockReader *reader = malloc(sizeof(GS_BlockReader));
+  GS_NOT_NULL(reader)
+  reader->path = path;
+  reader->data = data;
+  reader->entries = entries;
+  reader->count = count;
+  for (size_t i = 0; i < GS_PREFETCH_BLOCKS; i++) {
+    reader->slots[i].block = -1;
+    reader->slots[i].ready = false;
+    reader->slots[i].corrupted = false;
+    reader->slots[i].data = NULL;
+    reader->slots[i].capacity = 0;
+  }
+  reader->wanted = 0;
+  reader->working = true;
+  reader->mutex = SDL_CreateMutex();
+  GS_NOT_NULL(reader->mutex)
+  reader->changed = SDL_CreateCond();
+  GS_NOT_NULL(reader->changed)
+  reader->thread = SDL_CreateThread(blockThread, "blocks", reader);
+  GS_NOT_NULL(reader->thread)
+  *out = reader;
+  return GS_Ok();
+}
+
+void GS_DestroyBlockReader(GS_BlockReader *reader) {
+  SDL_LockMutex(reader->mutex);
+  reader->working = false;
+  SDL_CondBroadcast(reader->changed);
+  SDL_UnlockMutex(reader->mutex);
+  SDL_WaitThread(reader->thread, NULL);
+  for (size_t i = 0; i < GS_PREFETCH_BLOCKS; i++) {
+    free(reader->slots[i].data);
+  }
+  SDL_DestroyCond(reader->changed);
+  SDL_DestroyMutex(reader->mutex);
+  free(reader);
+}
+
+GS_Status *GS_ReadBlock(GS_BlockReader *reader, uint64_t block,
+                        uint8_t **data, size_t *size) {
+  if (block >= reader->count) {
+    return GS_IOError(reader->path);
+  }
+  SDL_LockMutex(reader->mutex);
+  if (reader->wanted != block) {
+    reader->wanted = block;
+    SDL_CondBroadcast(reader->changed);
+  }
+  if (!isCompressed(reader, block)) {
+    SDL_UnlockMutex(reader->mutex);
+    *data = storedData(reader, block);
+    *size = rawSize(reader, block);
+    return GS_Ok();
+  }
+  GS_BlockSlot *slot = findSlot(reader, block);
+  while (!slot || !slot->ready) {
+    SDL_CondWait(reader->changed, reader->mutex);
+    slot = findSlot(reader, block);
+  }
+  SDL_UnlockMutex(reader->mutex);
+  if (slot->corrupted) {
+    return GS_CorruptedData(reader->path);
+  }
+  *data = slot->data;
+  *size = rawSize(reader, block);
+  return GS_Ok();
+}
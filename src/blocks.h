@@ -0,0 +1,75 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
+#include "status.h"
+#include "utils.h"
+
+// Entries of the block table of a compressed container: a little-endian
+// uint64 offset, uint32 stored size and uint32 raw size. A block whose
+// stored size equals its raw size is not compressed.
+#define GS_BLOCK_ENTRY_SIZE 16
+
+typedef struct {
+  // -1 for a free slot
+  int64_t block;
+  bool ready;
+  bool corrupted;
+  uint8_t *data;
+  size_t capacity;
+} GS_BlockSlot;
+
+// Inflates the blocks of a compressed container on a background thread.
+// The thread keeps the block being read and the blocks after it ready, so
+// sequential reads do not wait for zlib.
+typedef struct {
+  char *path;
+  uint8_t *data;
+  uint8_t *entries;
+  uint64_t count;
+
+  // guarded by mutex
+  GS_BlockSlot slots[GS_PREFETCH_BLOCKS];
+  uint64_t wanted;
+  bool working;
+
+  SDL_mutex *mutex;
+  SDL_cond *changed;
+  SDL_Thread *thread;
+} GS_BlockReader;
+
+// Checks the block table against the blocks region [data, data + size) of
+// the mapped file and starts the thread.
+GS_Status *GS_CreateBlockReader(char *path, uint8_t *data, size_t size,
+                                uint8_t *entries, uint64_t count,
+                                GS_BlockReader **out);
+
+void GS_DestroyBlockReader(GS_BlockReader *reader);
+
+// Returns the raw block, waiting for the thread if it is not inflated yet.
+// The block stays valid until another block is read.
+GS_Status *GS_ReadBlock(GS_BlockReader *reader, uint64_t block,
+                        uint8_t **data, size_t *size);
@@ -0,0 +1,141 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "camera.h"
+
+#include "SDL_keyboard.h"
+#include "SDL_keycode.h"
+#include "SDL_mouse.h"
+#include "utils.h"
+
+void GS_InitCamera(GS_Camera *camera, int w, int h) {
+  camera->center = GS_VecMake(w / 2, h / 2);
+  camera->zoom = 1.0;
+  camera->width = w;
+  camera->height = h;
+  camera->dragging = false;
+}
+
+void GS_CameraWorldToScreen(const GS_Camera *camera, GS_Vec2 *world,
+                            GS_Vec2 *res) {
+  res->x = (world->x - camera->center.x) * camera->zoom + camera->width / 2;
+  res->y = (world->y - camera->center.y) * camera->zoom + camera->height / 2;
+}
+
+void GS_CameraScreenToWorld(const GS_Camera *camera, GS_Vec2 *screen,
+                            GS_Vec2 *res) {
+  res->x = (screen->x - camera->width / 2) / camera->zoom + camera->center.x;
+  res->y = (screen->y - camera->height / 2) / camera->zoom + camera->center.y;
+}
+
+void GS_CameraPan(GS_Camera *camera, double dx, double dy) {
+  // dx and dy are given in screen pixels
+  camera->center.x -= dx / camera->zoom;
+  camera->center.y -= dy / camera->zoom;
+}
+
+void GS_CameraZoom(GS_Camera *camera, double factor, GS_Vec2 *anchor) {
+  double zoom = camera->zoom * factor;
+  if (zoom < GS_CAMERA_MIN_ZOOM) {
+    zoom = GS_CAMERA_MIN_ZOOM;
+  }
+  if (zoom > GS_CAMERA_MAX_ZOOM) {
+    zoom = GS_CAMERA_MAX_ZOOM;
+  }
+  // keep the world point under the anchor in place
+  GS_Vec2 before;
+  GS_CameraScreenToWorld(camera, anchor, &before);
+  camera->zoom = zoom;
+  GS_Vec2 after;
+  GS_CameraScreenToWorld(camera, anchor, &after);
+  camera->center.x += before.x - after.x;
+  camera->center.y += before.y - after.y;
+}
+
+void GS_CameraVisibleRect(const GS_Camera *camera, GS_Rect *res) {
+  GS_Vec2 topLeft = GS_VecMake(0, 0);
+  GS_Vec2 bottomRight = GS_VecMake(camera->width, camera->height);
+  GS_CameraScreenToWorld(camera, &topLeft, &res->min);
+  GS_CameraScreenToWorld(camera, &bottomRight, &res->max);
+}
+
+bool GS_CameraHandleEvent(GS_Camera *camera, SDL_Event *event) {
+  GS_Vec2 middle = GS_VecMake(camera->width / 2, camera->height / 2);
+  switch (event->type) {
+  case SDL_KEYDOWN:
+    switch (event->key.keysym.sym) {
+    case SDLK_LEFT:
+      GS_CameraPan(camera, GS_CAMERA_PAN_STEP, 0);
+      return true;
+    case SDLK_RIGHT:
+      GS_CameraPan(camera, -GS_CAMERA_PAN_STEP, 0);
+      return true;
+    case SDLK_UP:
+      GS_CameraPan(camera, 0, GS_CAMERA_PAN_STEP);
+      return true;
+    case SDLK_DOWN:
+      GS_CameraPan(camera, 0, -GS_CAMERA_PAN_STEP);
+      return true;
+    case SDLK_EQUALS:
+    case SDLK_PLUS:
+    case SDLK_KP_PLUS:
+      GS_CameraZoom(camera, GS_CAMERA_ZOOM_STEP, &middle);
+      return true;
+    case SDLK_MINUS:
+    case SDLK_KP_MINUS:
+      GS_CameraZoom(camera, 1.0 / GS_CAMERA_ZOOM_STEP, &middle);
+      return true;
+    case SDLK_0:
+      GS_InitCamera(camera, camera->width, camera->height);
+      return true;
+    }
+    return false;
+  case SDL_MOUSEWHEEL: {
+    int x, y;
+    SDL_GetMouseState(&x, &y);
+    GS_Vec2 anchor = GS_VecMake(x, y);
+    double factor = event->wheel.y > 0 ? GS_CAMERA_ZOOM_STEP
+                                       : 1.0 / GS_CAMERA_ZOOM_STEP;
+    if (event->wheel.y != 0) {
+      GS_CameraZoom(camera, factor, &anchor);
+    }
+    return true;
+  }
+  case SDL_MOUSEBUTTONDOWN:
+    if (event->button.button == SDL_BUTTON_LEFT) {
+      camera->dragging = true;
+      return true;
+    }
+    return false;
+  case SDL_MOUSEBUTTONUP:
+    if (event->button.button == SDL_BUTTON_LEFT) {
+      camera->dragging = false;
+      return true;
+    }
+    return false;
+  case SDL_MOUSEMOTION:
+    if (camera->dragging) {
+      GS_CameraPan(camera, event->motion.xrel, event->motion.yrel);
+      return true;
+    }
+    return false;
+  }
+  return false;
+}
@@ -0,0 +1,50 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <stdbool.h>
+
+#include "SDL_events.h"
+#include "vector.h"
+
+typedef struct {
+  // world point shown in the middle of the window
+  GS_Vec2 center;
+  double zoom;
+  int width;
+  int height;
+  bool dragging;
+} GS_Camera;
+
+void GS_InitCamera(GS_Camera *camera, int w, int h);
+
+void GS_CameraWorldToScreen(const GS_Camera *camera, GS_Vec2 *world,
+                            GS_Vec2 *res);
+
+void GS_CameraScreenToWorld(const GS_Camera *camera, GS_Vec2 *screen,
+                            GS_Vec2 *res);
+
+void GS_CameraPan(GS_Camera *camera, double dx, double dy);
+
+void GS_CameraZoom(GS_Camera *camera, double factor, GS_Vec2 *anchor);
+
+void GS_CameraVisibleRect(const GS_Camera *camera, GS_Rect *res);
+
+bool GS_CameraHandleEvent(GS_Camera *camera, SDL_Event *event);
@@ -0,0 +1,80 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "changes.h"
+
+#include "utils.h"
+
+// Stores paths given as strings and as dictionary ids, returns the number
+// of stored paths.
+static size_t storePaths(GS_ChangeBatch *batch, char **paths,
+                         size_t paths_count, uint32_t *ids, size_t ids_count,
+                         GS_PathDictionary *dictionary, GS_Path *out) {
+  size_t count = 0;
+  for (size_t i = 0; i < paths_count; i++) {
+    GS_Status *status = GS_SplitPath(paths[i], batch->arena, &out[count]);
+    if (status->code == GS_StatusCode_OK) {
+      count++;
+    }
+    GS_WARN_NOT_OK(status)
+  }
+  char *components[GS_MAX_PATH_DEPTH];
+  size_t depth;
+  for (size_t i = 0; i < ids_count; i++) {
+    GS_Status *status =
+        GS_ResolvePath(dictionary, ids[i], components, &depth);
+    if (status->code == GS_StatusCode_OK) {
+      GS_MakePath(components, depth, batch->arena, &out[count++]);
+    }
+    GS_WARN_NOT_OK(status)
+  }
+  return count;
+}
+
+GS_Status *GS_CreateChangeBatch(Config__CommitInfo *commit, uint64_t index,
+                                GS_PathDictionary *dictionary,
+                                GS_ChangeBatch **out) {
+  GS_Arena *arena;
+  GS_RETURN_NOT_OK(GS_CreateArena(GS_RECORD_ARENA_SIZE, &arena))
+  GS_ChangeBatch *batch = GS_ArenaAlloc(arena, sizeof(GS_ChangeBatch));
+  batch->arena = arena;
+  batch->commit = index;
+  batch->epoch = 0;
+  batch->errors = commit->errors;
+
+  size_t added = commit->n_newfiles + commit->n_newfileids;
+  batch->added = GS_ArenaAlloc(arena, sizeof(GS_Path) * added);
+  batch->added_count =
+      storePaths(batch, commit->newfiles, commit->n_newfiles,
+                 commit->newfileids, commit->n_newfileids, dictionary,
+                 batch->added);
+  size_t removed = commit->n_deletedfiles + commit->n_deletedfileids;
+  batch->removed = GS_ArenaAlloc(arena, sizeof(GS_Path) * removed);
+  batch->removed_count =
+      storePaths(batch, commit->deletedfiles, commit->n_deletedfiles,
+                 commit->deletedfileids, commit->n_deletedfileids,
+                 dictionary, batch->removed);
+  *out = batch;
+  return GS_Ok();
+}
+
+void GS_DestroyChangeBatch(GS_ChangeBatch *batch) {
+  GS_DestroyArena(batch->arena);
+}
@@ -0,0 +1,55 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include "arena.h"
+#include "config.pb-c.h"
+#include "dictionary.h"
+#include "path.h"
+#include "status.h"
+
+// What a commit does to the tree, with its paths resolved, split and
+// hashed in advance. The batch lives in its own arena and refers neither
+// to the commit nor to the path dictionary, so it can be built on another
+// thread.
+typedef struct {
+  uint64_t commit;
+  // prefetch epoch the batch was built in
+  uint64_t epoch;
+  int32_t errors;
+
+  GS_Path *added;
+  size_t added_count;
+  GS_Path *removed;
+  size_t removed_count;
+
+  GS_Arena *arena;
+} GS_ChangeBatch;
+
+// Builds the batch of the commit with the given index. Paths that can not
+// be resolved are reported and skipped.
+GS_Status *GS_CreateChangeBatch(Config__CommitInfo *commit, uint64_t index,
+                                GS_PathDictionary *dictionary,
+                                GS_ChangeBatch **out);
+
+void GS_DestroyChangeBatch(GS_ChangeBatch *batch);
@@ -0,0 +1,105 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "dictionary.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils.h"
+
+GS_Status *GS_CreatePathDictionary(GS_PathDictionary **out) {
+  GS_PathDictionary *dictionary = malloc(sizeof(GS_PathDictionary));
+  GS_NOT_NULL(dictionary)
+  GS_RETURN_NOT_OK(
+      GS_CreateArena(GS_DICTIONARY_ARENA_SIZE, &dictionary->strings))
+  dictionary->components_count = 0;
+  dictionary->components_capacity = GS_INITIAL_DICTIONARY_CAPACITY;
+  dictionary->components =
+      malloc(sizeof(char *) * dictionary->components_capacity);
+  GS_NOT_NULL(dictionary->components)
+  dictionary->nodes_count = 0;
+  dictionary->nodes_capacity = GS_INITIAL_DICTIONARY_CAPACITY;
+  dictionary->nodes = malloc(sizeof(GS_PathNode) * dictionary->nodes_capacity);
+  GS_NOT_NULL(dictionary->nodes)
+  *out = dictionary;
+  return GS_Ok();
+}
+
+void GS_DestroyPathDictionary(GS_PathDictionary *dictionary) {
+  GS_DestroyArena(dictionary->strings);
+  free(dictionary->components);
+  free(dictionary->nodes);
+  free(dictionary);
+}
+
+#define GS_RESERVE(dictionary, field, count)                                   \
+  if (dictionary->field##_count + count > dictionary->field##_capacity) {      \
+    while (dictionary->field##_count + count > dictionary->field##_capacity) { \
+      dictionary->field##_capacity *= 2;                                       \
+    }                                                                          \
+    dictionary->field =                                                        \
+        realloc(dictionary->field,                                             \
+                sizeof(*dictionary->field) * dictionary->field##_capacity);    \
+    GS_NOT_NULL(dictionary->field)                                             \
+  }
+
+GS_Status *GS_ExtendPathDictionary(GS_PathDictionary *dictionary,
+                                   Config__PathDictionary *delta) {
+  GS_RESERVE(dictionary, components, delta->n_components)
+  for (size_t i = 0; i < delta->n_components; i++) {
+    size_t size = strlen(delta->components[i]) + 1;
+    char *component = GS_ArenaAlloc(dictionary->strings, size);
+    memcpy(component, delta->components[i], size);
+    dictionary->components[dictionary->components_count++] = component;
+  }
+
+  GS_RESERVE(dictionary, nodes, delta->n_nodes)
+  for (size_t i = 0; i < delta->n_nodes; i++) {
+    Config__PathNode *node = delta->nodes[i];
+    // a parent always comes before its children
+    if (node->parent > dictionary->nodes_count ||
+        node->component >= dictionary->components_count) {
+      return GS_CorruptedData("path dictionary");
+    }
+    GS_PathNode *res = &dictionary->nodes[dictionary->nodes_count++];
+    res->parent = node->parent;
+    res->name = dictionary->components[node->component];
+  }
+  return GS_Ok();
+}
+
+GS_Status *GS_ResolvePath(GS_PathDictionary *dictionary, uint32_t node,
+                          char **components, size_t *depth) {
+  if (node == 0 || node > dictionary->nodes_count) {
+    return GS_CorruptedData("path id");
+  }
+  size_t count = 0;
+  for (uint32_t id = node; id != 0; id = dictionary->nodes[id - 1].parent) {
+    if (++count > GS_MAX_PATH_DEPTH) {
+      return GS_CorruptedData("path id");
+    }
+  }
+  *depth = count;
+  for (uint32_t id = node; id != 0; id = dictionary->nodes[id - 1].parent) {
+    components[--count] = dictionary->nodes[id - 1].name;
+  }
+  return GS_Ok();
+}
@@ -0,0 +1,59 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include "arena.h"
+#include "config.pb-c.h"
+#include "status.h"
+
+typedef struct {
+  uint32_t parent;
+  char *name;
+} GS_PathNode;
+
+// Path components and nodes merged from the dictionaries in the input.
+// Node id i lives in nodes[i - 1], id 0 is the root.
+typedef struct {
+  GS_Arena *strings;
+
+  char **components;
+  size_t components_count;
+  size_t components_capacity;
+
+  GS_PathNode *nodes;
+  size_t nodes_count;
+  size_t nodes_capacity;
+} GS_PathDictionary;
+
+GS_Status *GS_CreatePathDictionary(GS_PathDictionary **out);
+
+void GS_DestroyPathDictionary(GS_PathDictionary *dictionary);
+
+// Appends the entries of delta, their strings are copied.
+GS_Status *GS_ExtendPathDictionary(GS_PathDictionary *dictionary,
+                                   Config__PathDictionary *delta);
+
+// Stores the components of the path of the node, at most
+// GS_MAX_PATH_DEPTH of them.
+GS_Status *GS_ResolvePath(GS_PathDictionary *dictionary, uint32_t node,
+                          char **components, size_t *depth);
@@ -0,0 +1,151 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "export.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "simulation.h"
+#include "utils.h"
+#include "window_manager.h"
+
+GS_Status *GS_CreateExporter(char *path, int w, int h, int fps,
+                             GS_Exporter **out) {
+  if (w % 2 || h % 2) {
+    return GS_IncorrectArgument("odd frame size");
+  }
+  FILE *fp = strcmp(path, "-") == 0 ? stdout : fopen(path, "wb");
+  if (!fp) {
+    return GS_IOError(path);
+  }
+  if (fprintf(fp, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", w, h, fps) <
+      0) {
+    if (fp != stdout) {
+      fclose(fp);
+    }
+    return GS_IOError(path);
+  }
+
+  GS_Exporter *exporter = malloc(sizeof(GS_Exporter));
+  GS_NOT_NULL(exporter)
+  exporter->out = fp;
+  exporter->width = w;
+  exporter->height = h;
+  exporter->frame = malloc(w * h * 3 / 2);
+  GS_NOT_NULL(exporter->frame)
+  *out = exporter;
+  return GS_Ok();
+}
+
+void GS_DestroyExporter(GS_Exporter *exporter) {
+  if (exporter->out == stdout) {
+    fflush(exporter->out);
+  } else {
+    fclose(exporter->out);
+  }
+  free(exporter->frame);
+  free(exporter);
+}
+
+static uint8_t clampComponent(int v) {
+  return v < 0 ? 0 : (v > 255 ? 255 : v);
+}
+
+GS_Status *GS_ExportFrame(GS_Exporter *exporter, SDL_Surface *surface) {
+  int w = exporter->width;
+  int h = exporter->height;
+  uint8_t *yPlane = exporter->frame;
+  uint8_t *uPlane = yPlane + w * h;
+  uint8_t *vPlane = uPlane + w * h / 4;
+
+  SDL_LockSurface(surface);
+  // full range BT.601 in 16.16 fixed point, chroma averaged over 2x2 blocks
+  for (int y = 0; y < h; y += 2) {
+    uint8_t *rows[2] = {(uint8_t *)surface->pixels + y * surface->pitch,
+                        (uint8_t *)surface->pixels + (y + 1) * surface->pitch};
+    for (int x = 0; x < w; x += 2) {
+      int r = 0, g = 0, b = 0;
+      for (int dy = 0; dy < 2; dy++) {
+        for (int dx = 0; dx < 2; dx++) {
+          uint8_t *px = rows[dy] + (x + dx) * 4;
+          yPlane[(y + dy) * w + x + dx] =
+              (19595 * px[0] + 38470 * px[1] + 7471 * px[2] + 32768) >> 16;
+          r += px[0];
+          g += px[1];
+          b += px[2];
+        }
+      }
+      int i = y / 2 * (w / 2) + x / 2;
+      uPlane[i] = clampComponent(
+          128 + (((-11059 * r - 21709 * g + 32768 * b) / 4 + 32768) >> 16));
+      vPlane[i] = clampComponent(
+          128 + (((32768 * r - 27439 * g - 5329 * b) / 4 + 32768) >> 16));
+    }
+  }
+  SDL_UnlockSurface(surface);
+
+  if (fputs("FRAME\n", exporter->out) < 0 ||
+      fwrite(exporter->frame, 1, w * h * 3 / 2, exporter->out) !=
+          (size_t)(w * h * 3 / 2)) {
+    return GS_IOError("exported video");
+  }
+  return GS_Ok();
+}
+
+GS_Status *GS_RunExport(GS_Options *options, GS_Loader *loader) {
+  GS_Exporter *exporter;
+  GS_RETURN_NOT_OK(GS_CreateExporter(options->export_path, options->width,
+                                     options->height, options->fps,
+                                     &exporter))
+  GS_WindowManager *wm;
+  GS_DESTROY_AND_RETURN_NOT_OK(
+      GS_CreateOffscreenWindowManager(options->width, options->height, &wm),
+      GS_DestroyExporter(exporter))
+  GS_Simulation *sim;
+  GS_DESTROY_AND_RETURN_NOT_OK(
+      GS_CreateSimulation(wm, loader, options, 0, &sim),
+      GS_DestroyWindowManager(wm);
+      GS_DestroyExporter(exporter))
+
+  // the virtual clock moves by exactly one frame per exported frame
+  double frame = 1000. / options->fps;
+  for (double now = 0; !GS_SimulationFinished(sim, now); now += frame) {
+    GS_Status *status = GS_AdvanceSimulation(sim, now);
+    if (status->code == GS_StatusCode_OK) {
+      wm->redraw = true;
+      status = GS_RenderWindowManager(wm);
+    }
+    if (status->code == GS_StatusCode_OK) {
+      status = GS_ExportFrame(exporter, wm->surface);
+    }
+    if (status->code != GS_StatusCode_OK) {
+      GS_DestroySimulation(sim);
+      GS_DestroyWindowManager(wm);
+      GS_DestroyExporter(exporter);
+      return status;
+    }
+  }
+
+  GS_DestroySimulation(sim);
+  GS_DestroyWindowManager(wm);
+  GS_DestroyExporter(exporter);
+  return GS_Ok();
+}
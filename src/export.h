@@ -0,0 +1,49 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+
+#include "SDL_surface.h"
+#include "loader.h"
+#include "options.h"
+#include "status.h"
+
+// Writes frames as a YUV4MPEG2 stream with 4:2:0 chroma subsampling.
+typedef struct {
+  FILE *out;
+  int width;
+  int height;
+  uint8_t *frame;
+} GS_Exporter;
+
+// path "-" writes to stdout. Width and height have to be even.
+GS_Status *GS_CreateExporter(char *path, int w, int h, int fps,
+                             GS_Exporter **out);
+
+void GS_DestroyExporter(GS_Exporter *exporter);
+
+// Converts an RGBA32 surface of the exporter size to a frame and writes it.
+GS_Status *GS_ExportFrame(GS_Exporter *exporter, SDL_Surface *surface);
+
+// Plays the whole history offscreen on a virtual clock and exports every
+// frame, as fast as the renderer allows.
+GS_Status *GS_RunExport(GS_Options *options, GS_Loader *loader);
@@ -0,0 +1,199 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "grid.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils.h"
+
+GS_Status *GS_CreateGrid(double cell_size, GS_Grid **out) {
+  GS_Grid *grid = malloc(sizeof(GS_Grid));
+  GS_NOT_NULL(grid)
+  grid->cell_size = cell_size;
+  grid->objects = NULL;
+  grid->objects_count = 0;
+  grid->objects_capacity = GS_INITIAL_GRID_CAPACITY;
+  grid->items = malloc(sizeof(size_t) * grid->objects_capacity);
+  GS_NOT_NULL(grid->items)
+  grid->item_buckets = malloc(sizeof(size_t) * grid->objects_capacity);
+  GS_NOT_NULL(grid->item_buckets)
+  grid->item_stamps = calloc(grid->objects_capacity, sizeof(uint32_t));
+  GS_NOT_NULL(grid->item_stamps)
+  grid->result = malloc(sizeof(size_t) * grid->objects_capacity);
+  GS_NOT_NULL(grid->result)
+  grid->result_count = 0;
+
+  grid->buckets_count = GS_INITIAL_GRID_CAPACITY;
+  grid->buckets_capacity = GS_INITIAL_GRID_CAPACITY;
+  grid->bucket_starts = malloc(sizeof(size_t) * (grid->buckets_capacity + 1));
+  GS_NOT_NULL(grid->bucket_starts)
+  grid->bucket_stamps = calloc(grid->buckets_capacity, sizeof(uint32_t));
+  GS_NOT_NULL(grid->bucket_stamps)
+  grid->stamp = 0;
+  *out = grid;
+  return GS_Ok();
+}
+
+void GS_DestroyGrid(GS_Grid *grid) {
+  free(grid->items);
+  free(grid->item_buckets);
+  free(grid->item_stamps);
+  free(grid->result);
+  free(grid->bucket_starts);
+  free(grid->bucket_stamps);
+  free(grid);
+}
+
+static int64_t cellCoord(GS_Grid *grid, double v) {
+  return (int64_t)floor(v / grid->cell_size);
+}
+
+static size_t hashCell(GS_Grid *grid, int64_t cx, int64_t cy) {
+  uint64_t h = (uint64_t)cx * 73856093u ^ (uint64_t)cy * 19349663u;
+  return h & (grid->buckets_count - 1);
+}
+
+static void resetStamps(GS_Grid *grid) {
+  memset(grid->bucket_stamps, 0, sizeof(uint32_t) * grid->buckets_capacity);
+  memset(grid->item_stamps, 0, sizeof(uint32_t) * grid->objects_capacity);
+  grid->stamp = 0;
+}
+
+static void reserveGrid(GS_Grid *grid, size_t count) {
+  if (count > grid->objects_capacity) {
+    while (grid->objects_capacity < count) {
+      grid->objects_capacity *= 2;
+    }
+    grid->items =
+        realloc(grid->items, sizeof(size_t) * grid->objects_capacity);
+    GS_NOT_NULL(grid->items)
+    grid->item_buckets =
+        realloc(grid->item_buckets, sizeof(size_t) * grid->objects_capacity);
+    GS_NOT_NULL(grid->item_buckets)
+    grid->result =
+        realloc(grid->result, sizeof(size_t) * grid->objects_capacity);
+    GS_NOT_NULL(grid->result)
+    grid->item_stamps =
+        realloc(grid->item_stamps, sizeof(uint32_t) * grid->objects_capacity);
+    GS_NOT_NULL(grid->item_stamps)
+    resetStamps(grid);
+  }
+
+  // keep the load factor of the bucket table not greater than one
+  grid->buckets_count = GS_INITIAL_GRID_CAPACITY;
+  while (grid->buckets_count < count) {
+    grid->buckets_count *= 2;
+  }
+  if (grid->buckets_count > grid->buckets_capacity) {
+    grid->buckets_capacity = grid->buckets_count;
+    grid->bucket_starts =
+        realloc(grid->bucket_starts,
+                sizeof(size_t) * (grid->buckets_capacity + 1));
+    GS_NOT_NULL(grid->bucket_starts)
+    grid->bucket_stamps =
+        realloc(grid->bucket_stamps, sizeof(uint32_t) * grid->buckets_capacity);
+    GS_NOT_NULL(grid->bucket_stamps)
+    resetStamps(grid);
+  }
+}
+
+void GS_RebuildGrid(GS_Grid *grid, GS_Object *objects, size_t count) {
+  reserveGrid(grid, count);
+  grid->objects = objects;
+  grid->objects_count = count;
+
+  // counting sort of objects by bucket
+  memset(grid->bucket_starts, 0, sizeof(size_t) * (grid->buckets_count + 1));
+  for (size_t i = 0; i < count; i++) {
+    GS_Vec2 pos = objects[i].center;
+    size_t bucket =
+        hashCell(grid, cellCoord(grid, pos.x), cellCoord(grid, pos.y));
+    grid->item_buckets[i] = bucket;
+    grid->bucket_starts[bucket + 1]++;
+  }
+  for (size_t b = 0; b < grid->buckets_count; b++) {
+    grid->bucket_starts[b + 1] += grid->bucket_starts[b];
+  }
+  // bucket_starts[b] is used as an insertion cursor and restored afterwards
+  for (size_t i = 0; i < count; i++) {
+    grid->items[grid->bucket_starts[grid->item_buckets[i]]++] = i;
+  }
+  for (size_t b = grid->buckets_count; b > 0; b--) {
+    grid->bucket_starts[b] = grid->bucket_starts[b - 1];
+  }
+  grid->bucket_starts[0] = 0;
+}
+
+static void nextStamp(GS_Grid *grid) {
+  if (++grid->stamp == 0) {
+    resetStamps(grid);
+    grid->stamp = 1;
+  }
+}
+
+size_t GS_QueryGrid(GS_Grid *grid, GS_Rect *rect) {
+  grid->result_count = 0;
+  nextStamp(grid);
+  int64_t x1 = cellCoord(grid, rect->min.x);
+  int64_t x2 = cellCoord(grid, rect->max.x);
+  int64_t y1 = cellCoord(grid, rect->min.y);
+  int64_t y2 = cellCoord(grid, rect->max.y);
+
+  if ((double)(x2 - x1 + 1) * (y2 - y1 + 1) >= grid->buckets_count) {
+    // the rect covers more cells than there are buckets, so a plain scan
+    // is cheaper than walking the cells
+    for (size_t i = 0; i < grid->objects_count; i++) {
+      if (GS_RectContains(rect, &grid->objects[i].center)) {
+        grid->result[grid->result_count++] = i;
+      }
+    }
+    return grid->result_count;
+  }
+
+  for (int64_t cy = y1; cy <= y2; cy++) {
+    for (int64_t cx = x1; cx <= x2; cx++) {
+      size_t bucket = hashCell(grid, cx, cy);
+      // different cells may share a bucket
+      if (grid->bucket_stamps[bucket] == grid->stamp) {
+        continue;
+      }
+      grid->bucket_stamps[bucket] = grid->stamp;
+      for (size_t k = grid->bucket_starts[bucket];
+           k < grid->bucket_starts[bucket + 1]; k++) {
+        size_t i = grid->items[k];
+        if (GS_RectContains(rect, &grid->objects[i].center)) {
+          grid->result[grid->result_count++] = i;
+        }
+      }
+    }
+  }
+  return grid->result_count;
+}
+
+bool GS_MarkGridItem(GS_Grid *grid, size_t index) {
+  if (grid->item_stamps[index] == grid->stamp) {
+    return false;
+  }
+  grid->item_stamps[index] = grid->stamp;
+  return true;
+}
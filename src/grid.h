@@ -0,0 +1,63 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "objects.h"
+#include "status.h"
+#include "vector.h"
+
+// Uniform grid over object centers. Cells are hashed into a power of two
+// bucket table, so the memory does not depend on how far the layout spreads.
+typedef struct {
+  double cell_size;
+
+  GS_Object *objects;
+  size_t objects_count;
+  size_t objects_capacity;
+  size_t *items;
+  size_t *item_buckets;
+  uint32_t *item_stamps;
+
+  size_t *bucket_starts;
+  uint32_t *bucket_stamps;
+  size_t buckets_count;
+  size_t buckets_capacity;
+  uint32_t stamp;
+
+  size_t *result;
+  size_t result_count;
+} GS_Grid;
+
+GS_Status *GS_CreateGrid(double cell_size, GS_Grid **out);
+
+void GS_DestroyGrid(GS_Grid *grid);
+
+void GS_RebuildGrid(GS_Grid *grid, GS_Object *objects, size_t count);
+
+// Collects indices of objects whose centers lie in rect into grid->result.
+size_t GS_QueryGrid(GS_Grid *grid, GS_Rect *rect);
+
+// Marks an object for the current query. Returns false if it was already
+// marked, which lets callers visit shared objects only once per frame.
+bool GS_MarkGridItem(GS_Grid *grid, size_t index);
@@ -0,0 +1,188 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "keyframes.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "objects.h"
+#include "utils.h"
+
+typedef struct {
+  uint8_t *data;
+  size_t size;
+  size_t capacity;
+} Writer;
+
+typedef struct {
+  uint8_t *data;
+  size_t offset;
+} Reader;
+
+static void put(Writer *writer, const void *value, size_t size) {
+  while (writer->size + size > writer->capacity) {
+    writer->capacity *= 2;
+    writer->data = realloc(writer->data, writer->capacity);
+    GS_NOT_NULL(writer->data)
+  }
+  memcpy(writer->data + writer->size, value, size);
+  writer->size += size;
+}
+
+static void take(Reader *reader, void *value, size_t size) {
+  memcpy(value, reader->data + reader->offset, size);
+  reader->offset += size;
+}
+
+// Names are stored with a length byte, positions and speeds as floats.
+// Everything else is derived from the object kind on restore.
+static void putObject(Writer *writer, char *name, GS_Object *obj) {
+  uint8_t length = strnlen(name, GS_MAX_NAME_SIZE - 1);
+  put(writer, &length, sizeof(length));
+  put(writer, name, length);
+  float values[4] = {obj->center.x, obj->center.y, obj->speed.x,
+                     obj->speed.y};
+  put(writer, values, sizeof(values));
+}
+
+static void takeObject(Reader *reader, char *name, GS_Object *obj) {
+  uint8_t length;
+  take(reader, &length, sizeof(length));
+  take(reader, name, length);
+  name[length] = '\0';
+  float values[4];
+  take(reader, values, sizeof(values));
+  obj->center = GS_VecMake(values[0], values[1]);
+  obj->speed = GS_VecMake(values[2], values[3]);
+}
+
+static void putFolder(Writer *writer, GS_Folder *folder) {
+  putObject(writer, folder->name, &folder->obj);
+  uint32_t counts[2] = {folder->files_count, folder->folders_count};
+  put(writer, counts, sizeof(counts));
+  for (size_t i = 0; i < folder->files_count; i++) {
+    GS_File *file = folder->files[i];
+    putObject(writer, file->name, &file->obj);
+    put(writer, &file->lines, sizeof(file->lines));
+  }
+  for (size_t i = 0; i < folder->folders_count; i++) {
+    putFolder(writer, folder->folders[i]);
+  }
+}
+
+static GS_Status *takeFolder(Reader *reader, GS_Folder *parent,
+                             GS_Folder **out) {
+  char name[GS_MAX_NAME_SIZE];
+  GS_Object obj;
+  takeObject(reader, name, &obj);
+  GS_Folder *folder;
+  GS_RETURN_NOT_OK(GS_AppendFolder(name, parent, &folder))
+  folder->obj.center = obj.center;
+  folder->obj.speed = obj.speed;
+
+  uint32_t counts[2];
+  take(reader, counts, sizeof(counts));
+  for (uint32_t i = 0; i < counts[0]; i++) {
+    takeObject(reader, name, &obj);
+    GS_File *file;
+    GS_RETURN_NOT_OK(GS_AppendFile(folder, name, &file))
+    file->obj.center = obj.center;
+    file->obj.speed = obj.speed;
+    take(reader, &file->lines, sizeof(file->lines));
+  }
+  for (uint32_t i = 0; i < counts[1]; i++) {
+    GS_Folder *child;
+    GS_RETURN_NOT_OK(takeFolder(reader, folder, &child))
+  }
+  *out = folder;
+  return GS_Ok();
+}
+
+GS_Status *GS_CreateKeyframeStore(uint64_t interval, GS_KeyframeStore **out) {
+  GS_KeyframeStore *store = malloc(sizeof(GS_KeyframeStore));
+  GS_NOT_NULL(store)
+  store->interval = interval;
+  store->frames_count = 0;
+  store->frames_capacity = GS_INITIAL_KEYFRAMES_CAPACITY;
+  store->frames = malloc(sizeof(GS_Keyframe) * store->frames_capacity);
+  GS_NOT_NULL(store->frames)
+  *out = store;
+  return GS_Ok();
+}
+
+void GS_DestroyKeyframeStore(GS_KeyframeStore *store) {
+  for (size_t i = 0; i < store->frames_count; i++) {
+    free(store->frames[i].data);
+  }
+  free(store->frames);
+  free(store);
+}
+
+GS_Status *GS_RecordKeyframe(GS_KeyframeStore *store, GS_WindowManager *wm,
+                             uint64_t commit) {
+  if (commit % store->interval != 0 ||
+      commit / store->interval != store->frames_count) {
+    return GS_Ok();
+  }
+  Writer writer = {NULL, 0, GS_INITIAL_KEYFRAME_SIZE};
+  writer.data = malloc(writer.capacity);
+  GS_NOT_NULL(writer.data)
+  put(&writer, &wm->currentColor, sizeof(wm->currentColor));
+  put(&writer, &wm->targetColor, sizeof(wm->targetColor));
+  putFolder(&writer, wm->root);
+
+  if (store->frames_count == store->frames_capacity) {
+    store->frames_capacity *= 2;
+    store->frames = realloc(store->frames,
+                            sizeof(GS_Keyframe) * store->frames_capacity);
+    GS_NOT_NULL(store->frames)
+  }
+  GS_Keyframe *frame = &store->frames[store->frames_count++];
+  frame->commit = commit;
+  frame->data = realloc(writer.data, writer.size);
+  GS_NOT_NULL(frame->data)
+  frame->size = writer.size;
+  return GS_Ok();
+}
+
+static size_t frameBefore(GS_KeyframeStore *store, uint64_t target) {
+  size_t index = target / store->interval;
+  return index < store->frames_count ? index : store->frames_count - 1;
+}
+
+uint64_t GS_KeyframeBefore(GS_KeyframeStore *store, uint64_t target) {
+  return store->frames[frameBefore(store, target)].commit;
+}
+
+GS_Status *GS_RestoreKeyframe(GS_KeyframeStore *store, GS_WindowManager *wm,
+                              uint64_t target, uint64_t *restored) {
+  GS_Keyframe *frame = &store->frames[frameBefore(store, target)];
+  Reader reader = {frame->data, 0};
+  take(&reader, &wm->currentColor, sizeof(wm->currentColor));
+  take(&reader, &wm->targetColor, sizeof(wm->targetColor));
+  GS_Folder *root;
+  GS_RETURN_NOT_OK(takeFolder(&reader, NULL, &root))
+  GS_SetGeneralColor(root, wm->currentColor);
+  GS_DestroyFolder(wm->root);
+  wm->root = root;
+  *restored = frame->commit;
+  return GS_Ok();
+}
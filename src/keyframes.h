@@ -0,0 +1,61 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include "status.h"
+#include "window_manager.h"
+
+// State of the tree after the first commit commits were applied, stored as
+// a compact binary blob.
+typedef struct {
+  uint64_t commit;
+  uint8_t *data;
+  size_t size;
+} GS_Keyframe;
+
+// Keyframes taken every interval commits. They are recorded while the
+// history is played, so frames[i] always holds commit i * interval.
+typedef struct {
+  uint64_t interval;
+  GS_Keyframe *frames;
+  size_t frames_count;
+  size_t frames_capacity;
+} GS_KeyframeStore;
+
+GS_Status *GS_CreateKeyframeStore(uint64_t interval, GS_KeyframeStore **out);
+
+void GS_DestroyKeyframeStore(GS_KeyframeStore *store);
+
+// Serialises the tree if commit is on the keyframe grid and was not stored
+// yet. Does nothing otherwise.
+GS_Status *GS_RecordKeyframe(GS_KeyframeStore *store, GS_WindowManager *wm,
+                             uint64_t commit);
+
+// Returns the commit of the nearest keyframe at or before target.
+uint64_t GS_KeyframeBefore(GS_KeyframeStore *store, uint64_t target);
+
+// Replaces the tree with the nearest keyframe at or before target and
+// stores its commit in restored. Commits from restored up to target have to
+// be replayed by the caller.
+GS_Status *GS_RestoreKeyframe(GS_KeyframeStore *store, GS_WindowManager *wm,
+                              uint64_t target, uint64_t *restored);
@@ -0,0 +1,628 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "loader.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "utils.h"
+
+static void pushOffset(GS_Loader *loader, uint64_t offset) {
+  if (loader->offsets_count == loader->offsets_capacity) {
+    loader->offsets_capacity *= 2;
+    loader->offsets =
+        realloc(loader->offsets, sizeof(uint64_t) * loader->offsets_capacity);
+    GS_NOT_NULL(loader->offsets)
+  }
+  loader->offsets[loader->offsets_count++] = offset;
+}
+
+// Reads a varint at *position, false if the data ends before it does.
+static bool parseVarint(uint8_t *data, size_t size, uint64_t *position,
+                        uint64_t *out) {
+  uint64_t res = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (*position >= size) {
+      return false;
+    }
+    uint8_t byte = data[(*position)++];
+    res |= (uint64_t)(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      *out = res;
+      return true;
+    }
+  }
+  return false;
+}
+
+static GS_Status *readVarint(GS_Loader *loader, uint8_t *data, size_t size,
+                             uint64_t *out) {
+  if (!parseVarint(data, size, &loader->position, out)) {
+    return GS_IOError(loader->path);
+  }
+  return GS_Ok();
+}
+
+static GS_Status *openLegacy(GS_Loader *loader) {
+  // the whole history shares one arena and is released at once
+  GS_RETURN_NOT_OK(GS_CreateArena(loader->size > GS_RECORD_ARENA_SIZE
+                                      ? loader->size
+                                      : GS_RECORD_ARENA_SIZE,
+                                  &loader->legacy_arena))
+  loader->legacy = config__out_config__unpack(
+      &loader->legacy_arena->allocator, loader->size, loader->data);
+  if (!loader->legacy) {
+    return GS_IOError(loader->path);
+  }
+  loader->commits_count = loader->legacy->n_commits;
+  if (loader->legacy->dictionary) {
+    // the whole dictionary makes the deltas of the commits redundant
+    loader->merged = loader->commits_count;
+    return GS_ExtendPathDictionary(loader->dictionary,
+                                   loader->legacy->dictionary);
+  }
+  for (; loader->merged < loader->commits_count; loader->merged++) {
+    Config__CommitInfo *commit = loader->legacy->commits[loader->merged];
+    if (commit->dictionary) {
+      GS_RETURN_NOT_OK(
+          GS_ExtendPathDictionary(loader->dictionary, commit->dictionary))
+    }
+  }
+  return GS_Ok();
+}
+
+// Maps the index and merges the whole dictionary from the trailer.
+static GS_Status *openTrailer(GS_Loader *loader, size_t header) {
+  if (loader->size < header + GS_TRAILER_FOOTER_SIZE) {
+    return GS_CorruptedData(loader->path);
+  }
+  uint8_t *footer = loader->data + loader->size - GS_TRAILER_FOOTER_SIZE;
+  uint64_t index = GS_ReadLittleEndian(footer, 8);
+  uint64_t dictionary = GS_ReadLittleEndian(footer + 8, 8);
+  uint64_t end = loader->size - GS_TRAILER_FOOTER_SIZE;
+  if (memcmp(footer + 16, GS_TRAILER_MAGIC, 4) != 0 ||
+      GS_ReadLittleEndian(footer + 20, 4) != GS_INDEX_ENTRY_SIZE ||
+      index < header || index > dictionary || dictionary > end ||
+      loader->commits_count > end / GS_INDEX_ENTRY_SIZE ||
+      dictionary - index != loader->commits_count * GS_INDEX_ENTRY_SIZE) {
+    return GS_CorruptedData(loader->path);
+  }
+  loader->index = loader->data + index;
+
+  GS_Arena *arena;
+  GS_RETURN_NOT_OK(GS_CreateArena(end - dictionary + 1, &arena))
+  Config__PathDictionary *delta = config__path_dictionary__unpack(
+      &arena->allocator, end - dictionary, loader->data + dictionary);
+  GS_Status *status = delta ? GS_ExtendPathDictionary(loader->dictionary, delta)
+                            : GS_CorruptedData(loader->path);
+  GS_DestroyArena(arena);
+  GS_RETURN_NOT_OK(status)
+  loader->merged = loader->commits_count;
+  return GS_Ok();
+}
+
+// Finds the block table in front of the index and starts inflating.
+static GS_Status *openBlocks(GS_Loader *loader) {
+  if (loader->size < GS_COMPRESSED_HEADER_SIZE) {
+    return GS_CorruptedData(loader->path);
+  }
+  loader->block_commits = GS_ReadLittleEndian(loader->data + 16, 4);
+  if (loader->block_commits == 0) {
+    return GS_CorruptedData(loader->path);
+  }
+  GS_RETURN_NOT_OK(openTrailer(loader, GS_COMPRESSED_HEADER_SIZE))
+  uint64_t count = loader->commits_count / loader->block_commits +
+                   (loader->commits_count % loader->block_commits != 0);
+  uint64_t index = loader->index - loader->data;
+  if (count > (index - GS_COMPRESSED_HEADER_SIZE) / GS_BLOCK_ENTRY_SIZE) {
+    return GS_CorruptedData(loader->path);
+  }
+  uint64_t table = index - count * GS_BLOCK_ENTRY_SIZE;
+  return GS_CreateBlockReader(loader->path, loader->data, table,
+                              loader->data + table, count, &loader->blocks);
+}
+
+static GS_Status *openContainer(GS_Loader *loader) {
+  uint8_t *header = loader->data;
+  uint32_t version = GS_ReadLittleEndian(header + GS_CONTAINER_MAGIC_SIZE, 4);
+  if (version == 0 || version > GS_CONTAINER_VERSION) {
+    return GS_IOError(loader->path);
+  }
+  loader->commits_count = GS_ReadLittleEndian(header + 8, 8);
+  if (version >= GS_COMPRESSED_VERSION) {
+    return openBlocks(loader);
+  }
+  if (version >= 2) {
+    return openTrailer(loader, GS_CONTAINER_HEADER_SIZE);
+  }
+  pushOffset(loader, GS_CONTAINER_HEADER_SIZE);
+  return GS_Ok();
+}
+
+// Writes what was read to the end of the spill file.
+static bool spillStream(GS_Loader *loader, uint8_t *chunk, size_t size) {
+  return fwrite(chunk, 1, size, loader->spill) == size &&
+         fflush(loader->spill) == 0;
+}
+
+// Counts the records that are complete with the chunk that was just
+// spilled and keeps the bytes of the incomplete one. Returns false if the
+// stream is not a streamed file.
+static bool appendStream(GS_Loader *loader, uint8_t *chunk, size_t size) {
+  if (loader->pending_size + size > loader->capacity) {
+    while (loader->pending_size + size > loader->capacity) {
+      loader->capacity *= 2;
+    }
+    loader->pending = realloc(loader->pending, loader->capacity);
+    GS_NOT_NULL(loader->pending)
+  }
+  memcpy(loader->pending + loader->pending_size, chunk, size);
+  loader->pending_size += size;
+  loader->size += size;
+  // stream offset of the first pending byte
+  uint64_t base = loader->size - loader->pending_size;
+
+  if (loader->offsets_count == 0) {
+    if (loader->size < GS_CONTAINER_HEADER_SIZE) {
+      return true;
+    }
+    if (memcmp(loader->pending, GS_CONTAINER_MAGIC,
+               GS_CONTAINER_MAGIC_SIZE) != 0 ||
+        GS_ReadLittleEndian(loader->pending + GS_CONTAINER_MAGIC_SIZE, 4) !=
+            GS_STREAM_VERSION) {
+      return false;
+    }
+    pushOffset(loader, GS_CONTAINER_HEADER_SIZE);
+  }
+  bool valid = true;
+  for (;;) {
+    uint64_t position = loader->offsets[loader->offsets_count - 1] - base;
+    uint64_t start = position;
+    uint64_t length;
+    if (!parseVarint(loader->pending, loader->pending_size, &position,
+                     &length)) {
+      // a varint takes at most ten bytes
+      valid = loader->pending_size - start < 10;
+      break;
+    }
+    if (length > loader->pending_size - position) {
+      break;
+    }
+    pushOffset(loader, base + position + length);
+    atomic_store(&loader->commits_count, loader->offsets_count - 1);
+  }
+
+  // complete records are only read back from the spill file
+  size_t consumed = loader->offsets[loader->offsets_count - 1] - base;
+  memmove(loader->pending, loader->pending + consumed,
+          loader->pending_size - consumed);
+  loader->pending_size -= consumed;
+  return valid;
+}
+
+// Stops reading the stream because it was cut short.
+static void cutStream(GS_Loader *loader, GS_Status *status) {
+  loader->stream_error = status->code;
+  GS_WARN_NOT_OK(status)
+  loader->reading = false;
+}
+
+static int streamThread(void *data) {
+  GS_Loader *loader = data;
+  uint8_t chunk[GS_STREAM_CHUNK_SIZE];
+  SDL_LockMutex(loader->lock);
+  while (loader->reading) {
+    uint64_t count = atomic_load(&loader->commits_count);
+    if (count > loader->wanted &&
+        count - loader->wanted >= loader->window_size) {
+      SDL_CondWaitTimeout(loader->consumed, loader->lock, GS_STREAM_POLL_MS);
+      continue;
+    }
+    SDL_UnlockMutex(loader->lock);
+    // poll, so that closing the loader does not wait for the writer
+    struct pollfd input = {.fd = loader->stream, .events = POLLIN};
+    int ready = poll(&input, 1, GS_STREAM_POLL_MS);
+    ssize_t size = ready > 0 ? read(loader->stream, chunk, sizeof(chunk)) : 0;
+    bool failed = (ready < 0 || size < 0) && errno != EINTR;
+    // records are counted only once they are in the file
+    bool spilled = size <= 0 || spillStream(loader, chunk, size);
+    SDL_LockMutex(loader->lock);
+    uint64_t before = atomic_load(&loader->commits_count);
+    if (!spilled || failed) {
+      cutStream(loader, GS_IOError(loader->path));
+    } else if (size > 0 && !appendStream(loader, chunk, size)) {
+      cutStream(loader, GS_CorruptedData(loader->path));
+    } else if (ready > 0 && size == 0 && loader->pending_size > 0) {
+      // the stream ended in the middle of a record
+      cutStream(loader, GS_CorruptedData(loader->path));
+    } else if (ready > 0 && size == 0) {
+      loader->reading = false;
+    }
+    SDL_CondBroadcast(loader->arrived);
+    if (loader->arrivals &&
+        atomic_load(&loader->commits_count) != before) {
+      SDL_SemPost(loader->arrivals);
+    }
+  }
+  // the writer gets an error instead of waiting for a reader that is gone
+  close(loader->stream);
+  atomic_store(&loader->complete, true);
+  SDL_CondBroadcast(loader->arrived);
+  if (loader->arrivals) {
+    SDL_SemPost(loader->arrivals);
+  }
+  SDL_UnlockMutex(loader->lock);
+  return 0;
+}
+
+// Starts reading standard input and waits for the first commit.
+static GS_Status *openStream(GS_Loader *loader) {
+  loader->stream = STDIN_FILENO;
+  loader->spill = tmpfile();
+  if (!loader->spill) {
+    return GS_IOError(loader->path);
+  }
+  loader->capacity = GS_STREAM_CHUNK_SIZE;
+  loader->pending = malloc(loader->capacity);
+  GS_NOT_NULL(loader->pending)
+  loader->record_capacity = GS_RECORD_ARENA_SIZE;
+  loader->record = malloc(loader->record_capacity);
+  GS_NOT_NULL(loader->record)
+  loader->consumed = SDL_CreateCond();
+  GS_NOT_NULL(loader->consumed)
+  loader->arrived = SDL_CreateCond();
+  GS_NOT_NULL(loader->arrived)
+  atomic_store(&loader->complete, false);
+  loader->reading = true;
+  loader->reader = SDL_CreateThread(streamThread, "stream", loader);
+  GS_NOT_NULL(loader->reader)
+
+  SDL_LockMutex(loader->lock);
+  while (atomic_load(&loader->commits_count) == 0 &&
+         !atomic_load(&loader->complete)) {
+    SDL_CondWait(loader->arrived, loader->lock);
+  }
+  SDL_UnlockMutex(loader->lock);
+  if (atomic_load(&loader->commits_count) == 0) {
+    return GS_CorruptedData(loader->path);
+  }
+  return GS_Ok();
+}
+
+static GS_Status *mapFile(GS_Loader *loader) {
+  int fd = open(loader->path, O_RDONLY);
+  if (fd < 0) {
+    return GS_FileNotFound(loader->path);
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    return GS_IOError(loader->path);
+  }
+  loader->size = info.st_size;
+  if (loader->size > 0) {
+    void *data = mmap(NULL, loader->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      close(fd);
+      return GS_IOError(loader->path);
+    }
+    loader->data = data;
+  }
+  // the mapping stays valid after the descriptor is closed
+  close(fd);
+  return GS_Ok();
+}
+
+GS_Status *GS_OpenLoader(char *path, size_t window, GS_Loader **out) {
+  GS_Loader *loader = malloc(sizeof(GS_Loader));
+  GS_NOT_NULL(loader)
+  loader->path = path;
+  loader->data = NULL;
+  loader->size = 0;
+  loader->position = 0;
+  loader->legacy = NULL;
+  loader->legacy_arena = NULL;
+  atomic_init(&loader->commits_count, 0);
+  atomic_init(&loader->complete, true);
+  GS_RETURN_NOT_OK(GS_CreatePathDictionary(&loader->dictionary))
+  loader->merged = 0;
+  loader->index = NULL;
+  loader->blocks = NULL;
+  loader->block_commits = 0;
+  loader->offsets_count = 0;
+  loader->offsets_capacity = GS_INITIAL_OFFSETS_CAPACITY;
+  loader->offsets = malloc(sizeof(uint64_t) * loader->offsets_capacity);
+  GS_NOT_NULL(loader->offsets)
+  // the previous commit is still needed when the next one is decoded
+  loader->window_size = window < 2 ? 2 : window;
+  loader->window = calloc(loader->window_size, sizeof(GS_LoadedCommit));
+  GS_NOT_NULL(loader->window)
+  loader->lock = SDL_CreateMutex();
+  GS_NOT_NULL(loader->lock)
+  loader->stream = -1;
+  loader->spill = NULL;
+  loader->pending = NULL;
+  loader->pending_size = 0;
+  loader->capacity = 0;
+  loader->record = NULL;
+  loader->record_capacity = 0;
+  loader->stream_error = GS_StatusCode_OK;
+  loader->reader = NULL;
+  loader->reading = false;
+  loader->wanted = 0;
+  loader->consumed = NULL;
+  loader->arrived = NULL;
+  loader->arrivals = NULL;
+
+  if (strcmp(path, GS_STREAM_PATH) == 0) {
+    GS_DESTROY_AND_RETURN_NOT_OK(openStream(loader), GS_CloseLoader(loader))
+    *out = loader;
+    return GS_Ok();
+  }
+  GS_DESTROY_AND_RETURN_NOT_OK(mapFile(loader), GS_CloseLoader(loader))
+  GS_Status *status;
+  if (loader->size >= GS_CONTAINER_HEADER_SIZE &&
+      memcmp(loader->data, GS_CONTAINER_MAGIC, GS_CONTAINER_MAGIC_SIZE) ==
+          0) {
+    status = openContainer(loader);
+  } else {
+    status = openLegacy(loader);
+  }
+  GS_DESTROY_AND_RETURN_NOT_OK(status, GS_CloseLoader(loader))
+  *out = loader;
+  return GS_Ok();
+}
+
+void GS_CloseLoader(GS_Loader *loader) {
+  if (loader->reader) {
+    SDL_LockMutex(loader->lock);
+    loader->reading = false;
+    SDL_CondSignal(loader->consumed);
+    SDL_UnlockMutex(loader->lock);
+    SDL_WaitThread(loader->reader, NULL);
+  }
+  if (loader->consumed) {
+    SDL_DestroyCond(loader->consumed);
+  }
+  if (loader->arrived) {
+    SDL_DestroyCond(loader->arrived);
+  }
+  if (loader->blocks) {
+    GS_DestroyBlockReader(loader->blocks);
+  }
+  for (size_t i = 0; i < loader->window_size; i++) {
+    if (loader->window[i].arena) {
+      GS_DestroyArena(loader->window[i].arena);
+    }
+  }
+  if (loader->legacy_arena) {
+    GS_DestroyArena(loader->legacy_arena);
+  }
+  if (loader->spill) {
+    fclose(loader->spill);
+  }
+  free(loader->pending);
+  free(loader->record);
+  if (loader->data) {
+    munmap(loader->data, loader->size);
+  }
+  GS_DestroyPathDictionary(loader->dictionary);
+  SDL_DestroyMutex(loader->lock);
+  free(loader->offsets);
+  free(loader->window);
+  free(loader);
+}
+
+uint64_t GS_LoaderCount(GS_Loader *loader) {
+  return atomic_load(&loader->commits_count);
+}
+
+bool GS_LoaderComplete(GS_Loader *loader) {
+  return atomic_load(&loader->complete);
+}
+
+void GS_NotifyLoaderArrivals(GS_Loader *loader, SDL_sem *sem) {
+  SDL_LockMutex(loader->lock);
+  loader->arrivals = sem;
+  SDL_UnlockMutex(loader->lock);
+}
+
+GS_Status *GS_LoaderStatus(GS_Loader *loader) {
+  SDL_LockMutex(loader->lock);
+  GS_StatusCode code = loader->stream_error;
+  SDL_UnlockMutex(loader->lock);
+  switch (code) {
+  case GS_StatusCode_OK:
+    return GS_Ok();
+  case GS_StatusCode_CorruptedData:
+    return GS_CorruptedData(loader->path);
+  default:
+    return GS_IOError(loader->path);
+  }
+}
+
+void GS_WaitLoaderComplete(GS_Loader *loader) {
+  SDL_LockMutex(loader->lock);
+  // lifts the limit on reading ahead
+  loader->wanted = UINT64_MAX;
+  if (loader->consumed) {
+    SDL_CondSignal(loader->consumed);
+  }
+  while (!atomic_load(&loader->complete)) {
+    SDL_CondWait(loader->arrived, loader->lock);
+  }
+  SDL_UnlockMutex(loader->lock);
+}
+
+void GS_LockLoader(GS_Loader *loader) { SDL_LockMutex(loader->lock); }
+
+void GS_UnlockLoader(GS_Loader *loader) { SDL_UnlockMutex(loader->lock); }
+
+// Reads the length of the record at the last known offset and remembers
+// where the next one starts.
+static GS_Status *skipRecord(GS_Loader *loader) {
+  loader->position = loader->offsets[loader->offsets_count - 1];
+  uint64_t length;
+  GS_RETURN_NOT_OK(readVarint(loader, loader->data, loader->size, &length))
+  pushOffset(loader, loader->position + length);
+  return GS_Ok();
+}
+
+// Reads a complete record of a stream back from the spill file.
+static GS_Status *readSpilled(GS_Loader *loader, uint64_t index,
+                              uint8_t **data, size_t *size) {
+  uint64_t start = loader->offsets[index];
+  size_t length = loader->offsets[index + 1] - start;
+  if (length > loader->record_capacity) {
+    while (length > loader->record_capacity) {
+      loader->record_capacity *= 2;
+    }
+    loader->record = realloc(loader->record, loader->record_capacity);
+    GS_NOT_NULL(loader->record)
+  }
+  int fd = fileno(loader->spill);
+  for (size_t done = 0; done < length;) {
+    ssize_t n = pread(fd, loader->record + done, length - done, start + done);
+    if (n <= 0 && errno != EINTR) {
+      return GS_IOError(loader->path);
+    }
+    done += n > 0 ? n : 0;
+  }
+  *data = loader->record;
+  *size = length;
+  return GS_Ok();
+}
+
+static GS_Status *decodeCommit(GS_Loader *loader, uint64_t index) {
+  GS_LoadedCommit *slot = &loader->window[index % loader->window_size];
+  if (slot->commit && slot->index == index) {
+    return GS_Ok();
+  }
+  uint8_t *data = loader->data;
+  size_t size = loader->size;
+  if (loader->blocks) {
+    GS_RETURN_NOT_OK(GS_ReadBlock(
+        loader->blocks, index / loader->block_commits, &data, &size))
+  }
+  if (loader->spill) {
+    GS_RETURN_NOT_OK(readSpilled(loader, index, &data, &size))
+    loader->position = 0;
+  } else if (loader->index) {
+    loader->position =
+        GS_ReadLittleEndian(loader->index + index * GS_INDEX_ENTRY_SIZE, 8);
+  } else {
+    while (loader->offsets_count <= index) {
+      GS_RETURN_NOT_OK(skipRecord(loader))
+    }
+    loader->position = loader->offsets[index];
+  }
+  uint64_t length;
+  GS_RETURN_NOT_OK(readVarint(loader, data, size, &length))
+  if (length > size - loader->position) {
+    return GS_IOError(loader->path);
+  }
+
+  if (slot->arena) {
+    GS_ResetArena(slot->arena);
+  } else {
+    GS_RETURN_NOT_OK(GS_CreateArena(GS_RECORD_ARENA_SIZE, &slot->arena))
+  }
+  slot->commit = config__commit_info__unpack(
+      &slot->arena->allocator, length, data + loader->position);
+  if (!slot->commit) {
+    return GS_IOError(loader->path);
+  }
+  slot->index = index;
+  loader->position += length;
+  if (loader->merged == index) {
+    if (slot->commit->dictionary) {
+      GS_RETURN_NOT_OK(GS_ExtendPathDictionary(loader->dictionary,
+                                               slot->commit->dictionary))
+    }
+    loader->merged++;
+  }
+  if (!loader->index && !loader->spill && loader->offsets_count == index + 1) {
+    pushOffset(loader, loader->position);
+  }
+  return GS_Ok();
+}
+
+GS_Status *GS_LoadCommit(GS_Loader *loader, uint64_t index,
+                         Config__CommitInfo **out) {
+  if (index >= atomic_load(&loader->commits_count)) {
+    return GS_IOError(loader->path);
+  }
+  if (index >= loader->wanted) {
+    loader->wanted = index + 1;
+    if (loader->consumed) {
+      SDL_CondSignal(loader->consumed);
+    }
+  }
+  if (loader->legacy) {
+    *out = loader->legacy->commits[index];
+    return GS_Ok();
+  }
+  GS_LoadedCommit *slot = &loader->window[index % loader->window_size];
+  if (!slot->commit || slot->index != index) {
+    // read ahead half a window, the other half keeps recent commits
+    uint64_t end = index + loader->window_size / 2;
+    uint64_t count = atomic_load(&loader->commits_count);
+    if (end > count) {
+      end = count;
+    }
+    uint64_t start = index < loader->merged ? index : loader->merged;
+    for (uint64_t i = start; i < end; i++) {
+      GS_RETURN_NOT_OK(decodeCommit(loader, i))
+    }
+  }
+  *out = slot->commit;
+  return GS_Ok();
+}
+
+GS_Status *GS_LoadSummary(GS_Loader *loader, uint64_t index,
+                          GS_CommitSummary *out) {
+  if (loader->index && index < loader->commits_count) {
+    uint8_t *entry = loader->index + index * GS_INDEX_ENTRY_SIZE;
+    out->timestamp = GS_ReadLittleEndian(entry + 8, 8);
+    out->errors = GS_ReadLittleEndian(entry + 16, 4);
+    out->new_files = GS_ReadLittleEndian(entry + 20, 4);
+    out->deleted_files = GS_ReadLittleEndian(entry + 24, 4);
+    out->changed_files = GS_ReadLittleEndian(entry + 28, 4);
+    return GS_Ok();
+  }
+  Config__CommitInfo *commit;
+  GS_LockLoader(loader);
+  GS_DESTROY_AND_RETURN_NOT_OK(GS_LoadCommit(loader, index, &commit),
+                               GS_UnlockLoader(loader))
+  out->timestamp = commit->timestamp;
+  out->errors = commit->errors;
+  out->new_files = commit->n_newfiles + commit->n_newfileids;
+  out->deleted_files = commit->n_deletedfiles + commit->n_deletedfileids;
+  out->changed_files = commit->n_changedfiles + commit->n_changedfileids;
+  GS_UnlockLoader(loader);
+  return GS_Ok();
+}
@@ -0,0 +1,186 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
+#include "arena.h"
+#include "blocks.h"
+#include "config.pb-c.h"
+#include "dictionary.h"
+#include "status.h"
+
+// A .gs file starts with GS_CONTAINER_MAGIC, a little-endian uint32
+// version and a little-endian uint64 commit count. Every commit follows as
+// a varint length and a serialised CommitInfo. Since version 2 the file
+// ends with a trailer: an index entry per commit, the whole path
+// dictionary and a footer with their offsets, GS_TRAILER_MAGIC and the
+// size of an index entry. All integers are little-endian.
+//
+// Version 3 files are compressed: the header carries a uint32 number of
+// commits per block and four reserved bytes, the records are grouped into
+// independently compressed blocks and the block table precedes the index.
+// Record offsets in the index are relative to the start of the raw block.
+//
+// A streamed file is read from standard input when the path is
+// GS_STREAM_PATH. It has version 1, a commit count with all bits set and
+// no trailer, and its commits become available as their records arrive.
+#define GS_CONTAINER_MAGIC "GSTM"
+#define GS_CONTAINER_MAGIC_SIZE 4
+#define GS_CONTAINER_HEADER_SIZE 16
+#define GS_CONTAINER_VERSION 3
+#define GS_COMPRESSED_VERSION 3
+#define GS_COMPRESSED_HEADER_SIZE 24
+#define GS_TRAILER_MAGIC "GSIX"
+#define GS_TRAILER_FOOTER_SIZE 24
+#define GS_INDEX_ENTRY_SIZE 32
+#define GS_STREAM_PATH "-"
+#define GS_STREAM_VERSION 1
+
+// What the index knows about a commit without decoding it.
+typedef struct {
+  int64_t timestamp;
+  int32_t errors;
+  uint32_t new_files;
+  uint32_t deleted_files;
+  uint32_t changed_files;
+} GS_CommitSummary;
+
+// A decoded commit, unpacked into an arena owned by its window slot.
+typedef struct {
+  uint64_t index;
+  Config__CommitInfo *commit;
+  GS_Arena *arena;
+} GS_LoadedCommit;
+
+// Decodes commits on demand straight from the read-only mapped file and
+// keeps at most window of them in memory. Files written as a single
+// OutConfig message are still accepted and are unpacked at once.
+//
+// Commits are decoded on the prefetch thread while the simulation reads
+// summaries, lock guards the window and the dictionary.
+//
+// A stream is spilled to an unlinked temporary file by the reader thread,
+// which counts the complete records under the lock. Seeking back reads the
+// records from the file, only the record being received and the one being
+// decoded are kept in memory. The reader stops reading once a window of
+// commits past the last one loaded is spilled, so the writer blocks on the
+// full pipe until playback needs more.
+typedef struct {
+  char *path;
+  uint8_t *data;
+  size_t size;
+  uint64_t position;
+  Config__OutConfig *legacy;
+  GS_Arena *legacy_arena;
+  atomic_ullong commits_count;
+  // false while a stream may still bring commits
+  atomic_bool complete;
+
+  // path dictionary with the deltas of the first merged commits
+  GS_PathDictionary *dictionary;
+  uint64_t merged;
+
+  // index entries in the mapped trailer, NULL for files without one
+  uint8_t *index;
+
+  // inflates the blocks of compressed files, NULL otherwise
+  GS_BlockReader *blocks;
+  uint32_t block_commits;
+
+  // offsets of the records seen so far, commit i starts at offsets[i];
+  // only used without an index
+  uint64_t *offsets;
+  size_t offsets_count;
+  size_t offsets_capacity;
+
+  // commit i lives in window[i % window_size]
+  GS_LoadedCommit *window;
+  size_t window_size;
+
+  SDL_mutex *lock;
+
+  // standard input for a stream, -1 for mapped files
+  int stream;
+  FILE *spill;
+  // the bytes of the incomplete record, size counts every byte received
+  uint8_t *pending;
+  size_t pending_size;
+  size_t capacity;
+  // the record being decoded
+  uint8_t *record;
+  size_t record_capacity;
+  // GS_StatusCode_OK unless the stream was cut short
+  GS_StatusCode stream_error;
+  SDL_Thread *reader;
+  bool reading;
+  // commits up to wanted were loaded, the reader waits on consumed to go
+  // further and signals arrived when records arrive or the stream ends
+  uint64_t wanted;
+  SDL_cond *consumed;
+  SDL_cond *arrived;
+  // posted by the reader as well when records arrive or the stream ends
+  SDL_sem *arrivals;
+} GS_Loader;
+
+GS_Status *GS_OpenLoader(char *path, size_t window, GS_Loader **out);
+
+void GS_CloseLoader(GS_Loader *loader);
+
+// The number of commits available so far.
+uint64_t GS_LoaderCount(GS_Loader *loader);
+
+// Whether GS_LoaderCount is final, always the case for files.
+bool GS_LoaderComplete(GS_Loader *loader);
+
+// Reads the rest of a stream, for consumers that need the whole history.
+void GS_WaitLoaderComplete(GS_Loader *loader);
+
+// An error if the stream was cut short by a partial record or by a read or
+// spill failure, GS_Ok() otherwise.
+GS_Status *GS_LoaderStatus(GS_Loader *loader);
+
+// Posts sem whenever a stream brings commits or ends, for threads that
+// wait on a semaphore rather than on the loader. NULL stops it.
+void GS_NotifyLoaderArrivals(GS_Loader *loader, SDL_sem *sem);
+
+// The lock is recursive. Hold it from GS_LoadCommit until the commit is not
+// used any more if other threads use the loader.
+void GS_LockLoader(GS_Loader *loader);
+
+void GS_UnlockLoader(GS_Loader *loader);
+
+// Reads the summary from the index, or decodes the commit under the lock if
+// the file has no index.
+GS_Status *GS_LoadSummary(GS_Loader *loader, uint64_t index,
+                          GS_CommitSummary *out);
+
+// Returns the commit with the given index, decoding it and the commits
+// after it if it is not in the window. Dictionary deltas are merged in
+// commit order, so skipped commits before it are decoded as well. The
+// commit stays valid until the window moves past it.
+GS_Status *GS_LoadCommit(GS_Loader *loader, uint64_t index,
+                         Config__CommitInfo **out);
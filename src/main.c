@@ -22,7 +22,6 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <sys/time.h>
 
 #include "SDL.h"
 #include "SDL_error.h"
@@ -30,73 +29,82 @@
 #include "SDL_keyboard.h"
 #include "SDL_keycode.h"
 #include "SDL_log.h"
-#include "config.pb-c.h"
+#include "export.h"
+#include "loader.h"
+#include "options.h"
+#include "simulation.h"
 #include "status.h"
 #include "utils.h"
 #include "window_manager.h"
 
 int main(int argc, char *argv[]) {
 
-  GS_PANIC_NOT_OK(GS_CheckArgc(argc));
+  GS_Options options;
+  GS_PANIC_NOT_OK(GS_ParseOptions(argc, argv, &options));
 
-  // TODO: split logic to functions
-  FILE *fp;
-  fp = fopen(argv[1], "r+");
+  GS_Loader *loader;
+  GS_PANIC_NOT_OK(GS_OpenLoader(options.input, options.window, &loader))
 
-  if (!fp) {
-    GS_PANIC_NOT_OK(GS_FileNotFound(argv[1]));
+  if (options.export_path) {
+    // frames follow the history, not the wall clock, so a stream is read
+    // to its end first
+    GS_WaitLoaderComplete(loader);
+    GS_PANIC_NOT_OK(GS_LoaderStatus(loader))
+    // the software renderer draws into a surface, no video subsystem needed
+    if (SDL_Init(0) != 0) {
+      SDL_Log("Unable to initialize SDL: %s", SDL_GetError());
+      return 1;
+    }
+    GS_PANIC_NOT_OK(GS_RunExport(&options, loader))
+    GS_CloseLoader(loader);
+    SDL_Quit();
+    return 0;
   }
 
-  fseek(fp, 0, SEEK_END);
-  size_t sz = ftell(fp);
-  fseek(fp, 0L, SEEK_SET);
-
-  uint8_t *data = malloc(sz);
-  fread(data, sizeof(uint8_t), sz, fp);
-
-  fclose(fp);
-
-  Config__OutConfig *config = config__out_config__unpack(NULL, sz, data);
-  free(data);
-
   if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0) {
     SDL_Log("Unable to initialize SDL: %s", SDL_GetError());
     return 1;
   }
   GS_WindowManager *window_manager;
-  GS_PANIC_NOT_OK(GS_CreateWindowManager(1920, 1080, &window_manager))
+  GS_PANIC_NOT_OK(
+      GS_CreateWindowManager(options.width, options.height, &window_manager))
 
-  struct timeval lastUpdateObj, lastUpdateWM, curTime;
-  uint8_t iCommit = 0;
-  GS_WARN_NOT_OK(GS_UpdateObjects(window_manager, config->commits[iCommit]))
+  GS_Simulation *simulation;
+  GS_PANIC_NOT_OK(GS_CreateSimulation(window_manager, loader, &options,
+                                      GS_GetTimeMs(), &simulation))
+  GS_PANIC_NOT_OK(GS_StartSimulationThread(simulation))
   bool working = true;
-  gettimeofday(&lastUpdateObj, NULL);
-  gettimeofday(&lastUpdateWM, NULL);
+  double frame = 1000. / GS_FRAMES_PER_SECOND;
+  double nextFrame = GS_GetTimeMs();
   while (working) {
-    gettimeofday(&curTime, NULL);
+    // sleep until an event arrives or the next frame is due
+    double timeout = nextFrame - GS_GetTimeMs();
     SDL_Event event;
-    if (SDL_PollEvent(&event)) {
-      if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE) {
+    if (SDL_WaitEventTimeout(&event, timeout > 0 ? (int)timeout + 1 : 0)) {
+      if (event.type == SDL_QUIT ||
+          (event.type == SDL_KEYDOWN &&
+           event.key.keysym.sym == SDLK_ESCAPE)) {
         working = false;
+      } else if (!GS_HandleSimulationEvent(simulation, &event)) {
+        GS_HandleWindowEvent(window_manager, &event);
       }
     }
-    if ((curTime.tv_sec - lastUpdateObj.tv_sec) >= GS_COMMITS_INTERVAL &&
-        iCommit < (config->n_commits - 1)) {
-      GS_WARN_NOT_OK(
-          GS_UpdateObjects(window_manager, config->commits[++iCommit]))
-      lastUpdateObj = curTime;
-    }
-
-    if (((double)(curTime.tv_usec - lastUpdateWM.tv_usec)) / 1000 +
-            (curTime.tv_sec - lastUpdateWM.tv_sec) * 1000 >=
-        1000. / GS_TICS_PER_SECOND / GS_MICROTICKS_PER_TICK) {
-      lastUpdateWM = curTime;
-      GS_WARN_NOT_OK(GS_UpdateColors(window_manager))
-      GS_WARN_NOT_OK(GS_UpdateWindowManager(window_manager))
+    double now = GS_GetTimeMs();
+    if (now >= nextFrame) {
+      GS_WARN_NOT_OK(GS_RenderWindowManager(window_manager))
+      nextFrame += frame;
+      if (nextFrame < now) {
+        nextFrame = now + frame;
+      }
     }
   }
-  config__out_config__free_unpacked(config, NULL);
+  GS_StopSimulationThread(simulation);
+  GS_DestroySimulation(simulation);
+  // a stream that was cut short is reported once the viewer is closed
+  GS_Status *status = GS_LoaderStatus(loader);
+  GS_CloseLoader(loader);
   GS_DestroyWindowManager(window_manager);
   SDL_Quit();
+  GS_PANIC_NOT_OK(status)
   return 0;
 }
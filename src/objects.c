@@ -27,45 +27,82 @@
 #include "utils.h"
 #include "vector.h"
 
-bool GS_NameExists(GS_Folder *root, char *name) {
-// We can not create folder with the same name as file, so we don't need
-// separate methods for folders and files
-#define GS_CHECK_NAME_EXISTS(array)                                            \
-  for (size_t i = 0; i < root->array##_count; i++) {                           \
-    if (strncmp((*(root->array + i))->name, name, GS_MAX_NAME_SIZE) == 0) {    \
-      return true;                                                             \
-    }                                                                          \
+uint32_t GS_HashName(char *name) {
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < GS_MAX_NAME_SIZE && name[i]; i++) {
+    hash = (hash ^ (uint8_t)name[i]) * 16777619u;
   }
-  GS_CHECK_NAME_EXISTS(files)
-  GS_CHECK_NAME_EXISTS(folders)
-  return false;
+  return hash;
 }
 
 #define GS_FIND_INTERNAL(method, type, field)                                  \
-  static GS_Status *method(GS_Folder *folder, char *name, type **result,       \
-                           size_t *index) {                                    \
+  static type *method(GS_Folder *folder, char *name, uint32_t hash,            \
+                      size_t *index) {                                         \
     for (size_t i = 0; i < folder->field##_count; i++) {                       \
       type *cur = folder->field[i];                                            \
-      if (strncmp(cur->name, name, GS_MAX_NAME_SIZE) == 0) {                   \
-        if (result)                                                            \
-          *result = cur;                                                       \
+      if (cur->hash == hash &&                                                 \
+          strncmp(cur->name, name, GS_MAX_NAME_SIZE) == 0) {                   \
         if (index)                                                             \
           *index = i;                                                          \
-        return GS_Ok();                                                        \
+        return cur;                                                            \
       }                                                                        \
     }                                                                          \
-    return type##NotFound(name);                                               \
+    return NULL;                                                               \
   }
 
 GS_FIND_INTERNAL(findFile, GS_File, files)
 GS_FIND_INTERNAL(findFolder, GS_Folder, folders)
 
+bool GS_NameExists(GS_Folder *root, char *name) {
+  // We can not create folder with the same name as file, so we don't need
+  // separate methods for folders and files
+  uint32_t hash = GS_HashName(name);
+  return findFile(root, name, hash, NULL) ||
+         findFolder(root, name, hash, NULL);
+}
+
+GS_File *GS_LookupFile(GS_Folder *folder, char *name, uint32_t hash) {
+  return findFile(folder, name, hash, NULL);
+}
+
+GS_Folder *GS_LookupFolder(GS_Folder *folder, char *name, uint32_t hash) {
+  return findFolder(folder, name, hash, NULL);
+}
+
+GS_Status *GS_WalkPath(GS_Folder *root, GS_Path *path, size_t depth,
+                       GS_Folder **out) {
+  for (size_t i = 0; i + 1 < depth; i++) {
+    char *name = GS_PathComponent(path, i);
+    root = findFolder(root, name, path->hashes[i], NULL);
+    if (!root) {
+      return GS_FolderNotFound(name);
+    }
+  }
+  *out = root;
+  return GS_Ok();
+}
+
 GS_Status *GS_FindFile(GS_Folder *folder, char *name, GS_File **result) {
-  return findFile(folder, name, result, NULL);
+  GS_File *file = findFile(folder, name, GS_HashName(name), NULL);
+  if (!file) {
+    return GS_FileNotFound(name);
+  }
+  if (result) {
+    *result = file;
+  }
+  return GS_Ok();
 }
 
 GS_Status *GS_FindFolder(GS_Folder *root, char *name, GS_Folder **result) {
-  return findFolder(root, name, result, NULL);
+  GS_Folder *folder = findFolder(root, name, GS_HashName(name), NULL);
+  if (!folder) {
+    return GS_FolderNotFound(name);
+  }
+  if (result) {
+    *result = folder;
+  }
+  return GS_Ok();
 }
 
 #define GS_ADD_TO_ARRAY_UNCHECKED(method, type, field)                         \
@@ -86,10 +123,14 @@ GS_Status *GS_CreateFolder(char *name, GS_Folder *parent, GS_Folder **out) {
   if (parent && GS_NameExists(parent, name)) {
     return GS_ObjectAlreadyExists(name);
   }
+  return GS_AppendFolder(name, parent, out);
+}
 
+GS_Status *GS_AppendFolder(char *name, GS_Folder *parent, GS_Folder **out) {
   GS_Folder *result = malloc(sizeof(GS_Folder));
   GS_NOT_NULL(result)
   GS_NOT_NULL(strncpy(result->name, name, GS_MAX_NAME_SIZE))
+  result->hash = GS_HashName(name);
 
   if (parent) {
     // we add some offset to make vector between that points
@@ -124,9 +165,14 @@ GS_Status *GS_CreateFile(GS_Folder *folder, char *name, GS_File **out) {
   if (GS_NameExists(folder, name)) {
     return GS_ObjectAlreadyExists(name);
   }
+  return GS_AppendFile(folder, name, out);
+}
+
+GS_Status *GS_AppendFile(GS_Folder *folder, char *name, GS_File **out) {
   GS_File *file = malloc(sizeof(GS_File));
   GS_NOT_NULL(file)
   GS_NOT_NULL(strncpy(file->name, name, GS_MAX_NAME_SIZE))
+  file->hash = GS_HashName(name);
 
   // we add some offset to make vector between that points
   // to have non-zero length
@@ -160,10 +206,12 @@ void GS_DestroyFolder(GS_Folder *folder) {
 }
 
 GS_Status *GS_RemoveFile(GS_Folder *folder, char *filename) {
-  GS_File *file;
   size_t index;
-  GS_RETURN_NOT_OK(findFile(folder, filename, &file, &index))
-  for (size_t i = index; i < folder->files_count; i++) {
+  GS_File *file = findFile(folder, filename, GS_HashName(filename), &index);
+  if (!file) {
+    return GS_FileNotFound(filename);
+  }
+  for (size_t i = index; i + 1 < folder->files_count; i++) {
     folder->files[i] = folder->files[i + 1];
   }
   folder->files_count--;
@@ -171,6 +219,20 @@ GS_Status *GS_RemoveFile(GS_Folder *folder, char *filename) {
   return GS_Ok();
 }
 
+GS_Status *GS_RemoveFolder(GS_Folder *parent, char *name) {
+  size_t index;
+  GS_Folder *folder = findFolder(parent, name, GS_HashName(name), &index);
+  if (!folder) {
+    return GS_FolderNotFound(name);
+  }
+  for (size_t i = index; i + 1 < parent->folders_count; i++) {
+    parent->folders[i] = parent->folders[i + 1];
+  }
+  parent->folders_count--;
+  GS_DestroyFolder(folder);
+  return GS_Ok();
+}
+
 GS_Status *GS_SetObjectColor(GS_Object *obj, SDL_Color color) {
   obj->color = color;
   return GS_Ok();
@@ -24,6 +24,7 @@
 #include <stdint.h>
 
 #include "SDL_pixels.h"
+#include "path.h"
 #include "utils.h"
 #include "vector.h"
 
@@ -38,12 +39,14 @@ typedef struct {
 typedef struct {
   GS_Object obj;
   char name[GS_MAX_NAME_SIZE];
+  uint32_t hash;
   uint64_t lines;
 } GS_File;
 
 typedef struct GS_Folder_ {
   GS_Object obj;
   char name[GS_MAX_NAME_SIZE];
+  uint32_t hash;
 
   GS_File **files;
   size_t files_count;
@@ -54,8 +57,23 @@ typedef struct GS_Folder_ {
   size_t folders_capacity;
 } GS_Folder;
 
+// Hash of the first GS_MAX_NAME_SIZE characters of the name, lookups
+// compare it before the names.
+uint32_t GS_HashName(char *name);
+
 bool GS_NameExists(GS_Folder *root, char *name);
 
+// Same as GS_FindFile and GS_FindFolder with the hash of the name computed
+// in advance. Return NULL if there is no such object.
+GS_File *GS_LookupFile(GS_Folder *folder, char *name, uint32_t hash);
+
+GS_Folder *GS_LookupFolder(GS_Folder *folder, char *name, uint32_t hash);
+
+// Walks down the folders named by the first depth - 1 components of the
+// path and stores the folder that holds component depth - 1.
+GS_Status *GS_WalkPath(GS_Folder *root, GS_Path *path, size_t depth,
+                       GS_Folder **out);
+
 GS_Status *GS_FindFile(GS_Folder *folder, char *name, GS_File **result);
 
 GS_Status *GS_FindFolder(GS_Folder *root, char *name, GS_Folder **result);
@@ -64,10 +82,19 @@ GS_Status *GS_CreateFolder(char *name, GS_Folder *parent, GS_Folder **out);
 
 GS_Status *GS_CreateFile(GS_Folder *folder, char *name, GS_File **out);
 
+// Same as GS_CreateFolder and GS_CreateFile but skip the name check, the
+// caller guarantees that the name is not taken.
+GS_Status *GS_AppendFolder(char *name, GS_Folder *parent, GS_Folder **out);
+
+GS_Status *GS_AppendFile(GS_Folder *folder, char *name, GS_File **out);
+
 void GS_DestroyFolder(GS_Folder *folder);
 
 GS_Status *GS_RemoveFile(GS_Folder *folder, char *filename);
 
+// Removes the folder together with everything inside it.
+GS_Status *GS_RemoveFolder(GS_Folder *parent, char *name);
+
 GS_Status *GS_SetObjectColor(GS_Object *obj, SDL_Color color);
 
 GS_Status *GS_SetGeneralColor(GS_Folder *folder, SDL_Color color);
\ No newline at end of file
@@ -0,0 +1,95 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "options.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils.h"
+
+static GS_Status *parsePositive(char *value, int *out) {
+  char *end;
+  long res = strtol(value, &end, 10);
+  if (*value == '\0' || *end != '\0' || res <= 0) {
+    return GS_IncorrectArgument(value);
+  }
+  *out = res;
+  return GS_Ok();
+}
+
+static GS_Status *parsePositiveDouble(char *value, double *out) {
+  char *end;
+  double res = strtod(value, &end);
+  if (*value == '\0' || *end != '\0' || !(res > 0) || !isfinite(res)) {
+    return GS_IncorrectArgument(value);
+  }
+  *out = res;
+  return GS_Ok();
+}
+
+static bool takesValue(char *arg) {
+  return strcmp(arg, "--export") == 0 || strcmp(arg, "--fps") == 0 ||
+         strcmp(arg, "--speed") == 0 || strcmp(arg, "--timescale") == 0 ||
+         strcmp(arg, "--lookahead") == 0;
+}
+
+GS_Status *GS_ParseOptions(int argc, char *argv[], GS_Options *out) {
+  out->input = NULL;
+  out->export_path = NULL;
+  out->width = GS_WINDOW_WIDTH;
+  out->height = GS_WINDOW_HEIGHT;
+  out->fps = GS_EXPORT_FPS;
+  out->mode = GS_PlaybackMode_Commits;
+  out->speed = 1. / GS_COMMITS_INTERVAL;
+  out->window = GS_LOOKAHEAD_COMMITS;
+
+  for (int i = 1; i < argc; i++) {
+    char *arg = argv[i];
+    if (takesValue(arg)) {
+      if (i + 1 == argc) {
+        return GS_IncorrectArgument(arg);
+      }
+      char *value = argv[++i];
+      if (strcmp(arg, "--export") == 0) {
+        out->export_path = value;
+      } else if (strcmp(arg, "--fps") == 0) {
+        GS_RETURN_NOT_OK(parsePositive(value, &out->fps))
+      } else if (strcmp(arg, "--lookahead") == 0) {
+        GS_RETURN_NOT_OK(parsePositive(value, &out->window))
+      } else {
+        out->mode = strcmp(arg, "--speed") == 0 ? GS_PlaybackMode_Commits
+                                                : GS_PlaybackMode_Time;
+        GS_RETURN_NOT_OK(parsePositiveDouble(value, &out->speed))
+      }
+    } else if (strncmp(arg, "--", 2) == 0 || out->input) {
+      return GS_IncorrectArgument(arg);
+    } else {
+      out->input = arg;
+    }
+  }
+
+  if (!out->input) {
+    return GS_IncorrectArgc(argc, 2);
+  }
+  return GS_Ok();
+}
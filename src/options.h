@@ -0,0 +1,44 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "playback.h"
+#include "status.h"
+
+typedef struct {
+  // path of the .gs file, "-" to read a stream from stdin
+  char *input;
+  // path of the exported video, "-" for stdout, NULL to open a window
+  char *export_path;
+  int width;
+  int height;
+  int fps;
+  GS_PlaybackMode mode;
+  // commits per second or seconds of history per second, depending on mode
+  double speed;
+  // number of decoded commits kept in memory
+  int window;
+} GS_Options;
+
+// Usage: gs_rendering [--export <file.y4m|->] [--fps <n>]
+//                     [--speed <commits/s> | --timescale <x>]
+//                     [--lookahead <commits>] <file.gs|->
+GS_Status *GS_ParseOptions(int argc, char *argv[], GS_Options *out);
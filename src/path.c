@@ -0,0 +1,95 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "path.h"
+
+#include <string.h>
+
+#include "objects.h"
+#include "utils.h"
+
+static void allocPath(size_t depth, size_t size, GS_Arena *arena,
+                      GS_Path *out) {
+  out->buffer = GS_ArenaAlloc(arena, size);
+  out->offsets = GS_ArenaAlloc(arena, sizeof(uint32_t) * depth);
+  out->hashes = GS_ArenaAlloc(arena, sizeof(uint32_t) * depth);
+  out->depth = depth;
+}
+
+GS_Status *GS_SplitPath(char *string, GS_Arena *arena, GS_Path *out) {
+  size_t depth = 0;
+  size_t size = 0;
+  for (char *ptr = string; *ptr; ptr++) {
+    if (*ptr != '/') {
+      depth += ptr == string || ptr[-1] == '/';
+      size++;
+    }
+  }
+  if (depth == 0 || depth > GS_MAX_PATH_DEPTH) {
+    return GS_IncorrectArgument(string);
+  }
+  allocPath(depth, size + depth, arena, out);
+  size_t index = 0;
+  char *end = out->buffer;
+  for (char *ptr = string; *ptr;) {
+    if (*ptr == '/') {
+      ptr++;
+      continue;
+    }
+    size_t length = strcspn(ptr, "/");
+    out->offsets[index] = end - out->buffer;
+    memcpy(end, ptr, length);
+    end[length] = '\0';
+    out->hashes[index++] = GS_HashName(end);
+    end += length + 1;
+    ptr += length;
+  }
+  return GS_Ok();
+}
+
+void GS_MakePath(char **components, size_t depth, GS_Arena *arena,
+                 GS_Path *out) {
+  size_t size = 0;
+  for (size_t i = 0; i < depth; i++) {
+    size += strlen(components[i]) + 1;
+  }
+  allocPath(depth, size, arena, out);
+  char *end = out->buffer;
+  for (size_t i = 0; i < depth; i++) {
+    size_t length = strlen(components[i]);
+    out->offsets[i] = end - out->buffer;
+    memcpy(end, components[i], length + 1);
+    out->hashes[i] = GS_HashName(end);
+    end += length + 1;
+  }
+}
+
+void GS_CopyPath(GS_Path *path, size_t depth, GS_Arena *arena, GS_Path *out) {
+  size_t last = path->offsets[depth - 1];
+  size_t size = last + strlen(path->buffer + last) + 1;
+  allocPath(depth, size, arena, out);
+  memcpy(out->buffer, path->buffer, size);
+  memcpy(out->offsets, path->offsets, sizeof(uint32_t) * depth);
+  memcpy(out->hashes, path->hashes, sizeof(uint32_t) * depth);
+}
+
+char *GS_PathComponent(GS_Path *path, size_t index) {
+  return path->buffer + path->offsets[index];
+}
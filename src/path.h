@@ -0,0 +1,51 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include "arena.h"
+#include "status.h"
+
+// A path split once into its components. The components are stored one
+// after another in buffer, each terminated by '\0'; component i starts at
+// offsets[i] and hashes[i] is its GS_HashName. Paths are never modified
+// once built, so they can be walked from any thread and any number of
+// times.
+typedef struct {
+  char *buffer;
+  uint32_t *offsets;
+  uint32_t *hashes;
+  size_t depth;
+} GS_Path;
+
+// Splits the '/' separated string into a path allocated in arena. Empty
+// components are skipped, the string is not modified.
+GS_Status *GS_SplitPath(char *string, GS_Arena *arena, GS_Path *out);
+
+// Builds a path of the given components in arena.
+void GS_MakePath(char **components, size_t depth, GS_Arena *arena,
+                 GS_Path *out);
+
+// Copies the first depth components of path into arena.
+void GS_CopyPath(GS_Path *path, size_t depth, GS_Arena *arena, GS_Path *out);
+
+char *GS_PathComponent(GS_Path *path, size_t index);
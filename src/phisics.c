@@ -37,6 +37,23 @@ GS_Status *GS_CreateBalancer(GS_Balancer **out) {
   GS_NOT_NULL(balancer->forces);
   balancer->is_file = malloc(sizeof(bool) * balancer->objects_capacity);
   GS_NOT_NULL(balancer->is_file);
+  balancer->parents = malloc(sizeof(size_t) * balancer->objects_capacity);
+  GS_NOT_NULL(balancer->parents);
+  balancer->bounds = malloc(sizeof(GS_Rect) * balancer->objects_capacity);
+  GS_NOT_NULL(balancer->bounds);
+  balancer->weights = malloc(sizeof(size_t) * balancer->objects_capacity);
+  GS_NOT_NULL(balancer->weights);
+  balancer->ends = malloc(sizeof(size_t) * balancer->objects_capacity);
+  GS_NOT_NULL(balancer->ends);
+  balancer->extents = malloc(sizeof(GS_Rect) * balancer->objects_capacity);
+  GS_NOT_NULL(balancer->extents);
+  balancer->dirty = calloc(balancer->objects_capacity, sizeof(bool));
+  GS_NOT_NULL(balancer->dirty);
+  balancer->moved = malloc(sizeof(size_t) * balancer->objects_capacity);
+  GS_NOT_NULL(balancer->moved);
+  balancer->moved_count = 0;
+  balancer->traced_count = 0;
+  balancer->retraced = true;
   balancer->connections =
       malloc(sizeof(GS_Pair) * balancer->connections_capacity);
   GS_NOT_NULL(balancer->connections);
@@ -51,26 +68,61 @@ static double coulombForce(double q1, double q2, double r) {
 
 static double gukeForce(double k, double dl) { return -k * dl; }
 
-static size_t traceObject(GS_Balancer *balancer, GS_Object *obj, bool is_file) {
+static size_t traceObject(GS_Balancer *balancer, GS_Object *obj, bool is_file,
+                          size_t parent) {
   if (balancer->objects_count == balancer->objects_capacity) {
     balancer->objects_capacity *= 2;
-    balancer->objects = realloc(balancer->objects, balancer->objects_capacity);
+    balancer->objects = realloc(
+        balancer->objects, sizeof(GS_Object *) * balancer->objects_capacity);
+    GS_NOT_NULL(balancer->objects);
     balancer->forces =
         realloc(balancer->forces, sizeof(GS_Vec2) * balancer->objects_capacity);
+    GS_NOT_NULL(balancer->forces);
     balancer->is_file =
         realloc(balancer->is_file, sizeof(bool) * balancer->objects_capacity);
+    GS_NOT_NULL(balancer->is_file);
+    balancer->parents =
+        realloc(balancer->parents, sizeof(size_t) * balancer->objects_capacity);
+    GS_NOT_NULL(balancer->parents);
+    balancer->bounds =
+        realloc(balancer->bounds, sizeof(GS_Rect) * balancer->objects_capacity);
+    GS_NOT_NULL(balancer->bounds);
+    balancer->weights =
+        realloc(balancer->weights, sizeof(size_t) * balancer->objects_capacity);
+    GS_NOT_NULL(balancer->weights);
+    balancer->ends =
+        realloc(balancer->ends, sizeof(size_t) * balancer->objects_capacity);
+    GS_NOT_NULL(balancer->ends);
+    balancer->extents = realloc(balancer->extents,
+                                sizeof(GS_Rect) * balancer->objects_capacity);
+    GS_NOT_NULL(balancer->extents);
+    balancer->dirty =
+        realloc(balancer->dirty, sizeof(bool) * balancer->objects_capacity);
+    GS_NOT_NULL(balancer->dirty);
+    balancer->moved =
+        realloc(balancer->moved, sizeof(size_t) * balancer->objects_capacity);
+    GS_NOT_NULL(balancer->moved);
   }
-  balancer->objects[balancer->objects_count] = obj;
-  balancer->is_file[balancer->objects_count] = is_file;
+  size_t ind = balancer->objects_count;
+  if (ind >= balancer->traced_count || balancer->objects[ind] != obj ||
+      balancer->is_file[ind] != is_file || balancer->parents[ind] != parent) {
+    balancer->retraced = true;
+  }
+  balancer->objects[ind] = obj;
+  balancer->is_file[ind] = is_file;
+  balancer->parents[ind] = parent;
+  balancer->ends[ind] = ind + 1;
   balancer->objects_count++;
-  return balancer->objects_count - 1;
+  return ind;
 }
 
 static void addConnection(GS_Balancer *balancer, size_t a, size_t b) {
   if (balancer->connections_count == balancer->connections_capacity) {
     balancer->connections_capacity *= 2;
     balancer->connections =
-        realloc(balancer->connections, balancer->connections_capacity);
+        realloc(balancer->connections,
+                sizeof(GS_Pair) * balancer->connections_capacity);
+    GS_NOT_NULL(balancer->connections);
   }
   GS_Pair p;
   p.first = a;
@@ -80,19 +132,106 @@ static void addConnection(GS_Balancer *balancer, size_t a, size_t b) {
 
 static void traceObjectImpl(GS_Balancer *balancer, GS_Folder *root,
                             size_t root_ind) {
-  int ind = traceObject(balancer, &root->obj, false);
+  // the root folder is traced as its own parent
+  size_t ind = traceObject(balancer, &root->obj, false, root_ind);
   addConnection(balancer, ind, root_ind);
   for (int i = 0; i < root->files_count; i++) {
     addConnection(balancer, ind,
-                  traceObject(balancer, &root->files[i]->obj, true));
+                  traceObject(balancer, &root->files[i]->obj, true, ind));
   }
   for (int i = 0; i < root->folders_count; i++) {
     traceObjectImpl(balancer, root->folders[i], ind);
   }
+  balancer->ends[ind] = balancer->objects_count;
 }
 
 void GS_TraceObjects(GS_Balancer *balancer, GS_Folder *root) {
   traceObjectImpl(balancer, root, 0);
+  if (balancer->objects_count != balancer->traced_count) {
+    balancer->retraced = true;
+  }
+}
+
+static void resetExtent(GS_Balancer *balancer, size_t i) {
+  GS_Object *obj = balancer->objects[i];
+  double r = obj->radius + GS_BOUNDS_MARGIN;
+  balancer->extents[i] = GS_RectMake(obj->center.x - r, obj->center.y - r,
+                                     obj->center.x + r, obj->center.y + r);
+}
+
+static bool leftExtent(GS_Balancer *balancer, size_t i) {
+  GS_Object *obj = balancer->objects[i];
+  GS_Rect *extent = &balancer->extents[i];
+  return obj->center.x - obj->radius < extent->min.x ||
+         obj->center.y - obj->radius < extent->min.y ||
+         obj->center.x + obj->radius > extent->max.x ||
+         obj->center.y + obj->radius > extent->max.y;
+}
+
+// Queues the object and its ancestors up to the first one already queued.
+static void markMoved(GS_Balancer *balancer, size_t i) {
+  while (!balancer->dirty[i]) {
+    balancer->dirty[i] = true;
+    balancer->moved[balancer->moved_count++] = i;
+    if (balancer->parents[i] == i) {
+      return;
+    }
+    i = balancer->parents[i];
+  }
+}
+
+// Notes an object that may have moved or been resized.
+static void checkExtent(GS_Balancer *balancer, size_t i) {
+  if (!balancer->retraced && leftExtent(balancer, i)) {
+    resetExtent(balancer, i);
+    markMoved(balancer, i);
+  }
+}
+
+static int compareDescending(const void *lhs, const void *rhs) {
+  size_t a = *(const size_t *)lhs;
+  size_t b = *(const size_t *)rhs;
+  return a < b ? 1 : a > b ? -1 : 0;
+}
+
+static void rebuildBounds(GS_Balancer *balancer) {
+  for (size_t i = 0; i < balancer->objects_count; i++) {
+    resetExtent(balancer, i);
+    balancer->bounds[i] = balancer->extents[i];
+    balancer->weights[i] = balancer->is_file[i] ? 1 : 0;
+    balancer->dirty[i] = false;
+  }
+  // objects are traced after their parents, so the reversed order
+  // visits every child before its parent
+  for (size_t i = balancer->objects_count; i-- > 1;) {
+    size_t parent = balancer->parents[i];
+    GS_RectUnion(&balancer->bounds[parent], &balancer->bounds[i],
+                 &balancer->bounds[parent]);
+    balancer->weights[parent] += balancer->weights[i];
+  }
+}
+
+static void updateBounds(GS_Balancer *balancer) {
+  if (balancer->retraced) {
+    rebuildBounds(balancer);
+    balancer->moved_count = 0;
+    balancer->retraced = false;
+    return;
+  }
+  // children before their parents, the weights do not change
+  qsort(balancer->moved, balancer->moved_count, sizeof(size_t),
+        compareDescending);
+  for (size_t k = 0; k < balancer->moved_count; k++) {
+    size_t i = balancer->moved[k];
+    balancer->bounds[i] = balancer->extents[i];
+    for (size_t child = i + 1; child < balancer->ends[i];
+         child = balancer->ends[child]) {
+      GS_RectUnion(&balancer->bounds[i], &balancer->bounds[child],
+                   &balancer->bounds[i]);
+    }
+    balancer->dirty[i] = false;
+  }
+  balancer->moved_count = 0;
 }
 
 void GS_Balance(GS_Balancer *balancer) {
@@ -152,6 +291,10 @@ void GS_Balance(GS_Balancer *balancer) {
     }
   }
 
+  // the root does not move but may be resized
+  if (balancer->objects_count > 0) {
+    checkExtent(balancer, 0);
+  }
   for (int i = 1; i < balancer->objects_count; i++) {
     GS_VecScalarMult(&balancer->objects[i]->speed, GS_SPEED_DAMPING,
                      &balancer->objects[i]->speed);
@@ -166,10 +309,14 @@ void GS_Balance(GS_Balancer *balancer) {
     GS_VecScalarDiv(&speed, GS_MICROTICKS_PER_TICK, &speed);
     GS_VecSum(&balancer->objects[i]->center, &speed,
               &balancer->objects[i]->center);
+    checkExtent(balancer, i);
   }
+
+  updateBounds(balancer);
 }
 
 void GS_ClearBalancer(GS_Balancer *balancer) {
+  balancer->traced_count = balancer->objects_count;
   balancer->objects_count = 0;
   balancer->connections_count = 0;
 }
@@ -179,5 +326,12 @@ void GS_DestroyBalancer(GS_Balancer *balancer) {
   free(balancer->forces);
   free(balancer->connections);
   free(balancer->is_file);
+  free(balancer->parents);
+  free(balancer->bounds);
+  free(balancer->weights);
+  free(balancer->ends);
+  free(balancer->extents);
+  free(balancer->dirty);
+  free(balancer->moved);
   free(balancer);
 }
@@ -37,6 +37,25 @@ typedef struct {
   GS_Object **objects;
   GS_Vec2 *forces;
   bool *is_file;
+  size_t *parents;
+  // objects are traced depth first, the subtree of object i ends before
+  // ends[i]
+  size_t *ends;
+  // bounds and file count of the subtree under every object. They are
+  // rebuilt when the traced tree changes and otherwise updated along the
+  // parent chains of the objects that left their extents.
+  GS_Rect *bounds;
+  size_t *weights;
+  // bounds of every object itself, padded by GS_BOUNDS_MARGIN so that
+  // small moves stay inside them
+  GS_Rect *extents;
+  // objects whose bounds are updated, each at most once per step
+  bool *dirty;
+  size_t *moved;
+  size_t moved_count;
+  // objects of the previous trace, retraced is set if this one differs
+  size_t traced_count;
+  bool retraced;
   size_t objects_count;
   size_t objects_capacity;
   GS_Pair *connections;
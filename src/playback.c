@@ -0,0 +1,144 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "playback.h"
+
+#include <math.h>
+
+#include "utils.h"
+
+// Distance in the history between the commit at the cursor and the
+// previous one.
+static GS_Status *commitGap(GS_Playback *playback, double *out) {
+  if (playback->mode == GS_PlaybackMode_Commits) {
+    *out = 1;
+    return GS_Ok();
+  }
+  GS_CommitSummary summary;
+  GS_RETURN_NOT_OK(
+      GS_LoadSummary(playback->loader, playback->cursor, &summary))
+  double gap = summary.timestamp;
+  GS_RETURN_NOT_OK(
+      GS_LoadSummary(playback->loader, playback->cursor - 1, &summary))
+  gap -= summary.timestamp;
+  // skip idle periods and ignore commits dated before their parents
+  double idle = playback->speed * GS_MAX_IDLE_SECONDS;
+  if (gap > idle) {
+    gap = idle;
+  }
+  *out = gap > 0 ? gap : 0;
+  return GS_Ok();
+}
+
+void GS_InitPlayback(GS_Playback *playback, GS_Loader *loader,
+                     GS_PlaybackMode mode, double speed, double now) {
+  playback->loader = loader;
+  playback->mode = mode;
+  playback->speed = speed;
+  playback->paused = false;
+  // the first commit is shown right away
+  GS_SeekPlayback(playback, 0, now);
+}
+
+void GS_SeekPlayback(GS_Playback *playback, uint64_t commit, double now) {
+  playback->cursor = commit;
+  playback->position = 0;
+  playback->next = 0;
+  playback->lastTime = now;
+  playback->lastApply = now - GS_MIN_BATCH_INTERVAL_MS;
+}
+
+GS_Status *GS_RewindPlayback(GS_Playback *playback, uint64_t commit,
+                             double now) {
+  playback->cursor = commit;
+  playback->position = 0;
+  playback->next = 0;
+  if (commit > 0) {
+    GS_RETURN_NOT_OK(commitGap(playback, &playback->next))
+  }
+  playback->lastTime = now;
+  playback->lastApply = now;
+  return GS_Ok();
+}
+
+static void moveClock(GS_Playback *playback, double now) {
+  if (!playback->paused) {
+    playback->position += (now - playback->lastTime) / 1000. * playback->speed;
+  }
+  playback->lastTime = now;
+}
+
+GS_Status *GS_AdvancePlayback(GS_Playback *playback, double now,
+                              uint64_t *first, uint64_t *count) {
+  moveClock(playback, now);
+
+  *first = playback->cursor;
+  *count = 0;
+  if (now - playback->lastApply < GS_MIN_BATCH_INTERVAL_MS) {
+    return GS_Ok();
+  }
+  uint64_t total = GS_LoaderCount(playback->loader);
+  while (playback->cursor < total && playback->next <= playback->position) {
+    playback->cursor++;
+    *count = playback->cursor - *first;
+    if (playback->cursor < total) {
+      double gap;
+      GS_RETURN_NOT_OK(commitGap(playback, &gap))
+      playback->next += gap;
+    }
+  }
+  if (*count > 0) {
+    playback->lastApply = now;
+  }
+  if (playback->cursor == total && playback->position > playback->next) {
+    // a stream may bring more commits, they should not arrive all at once
+    playback->position = playback->next;
+  }
+  return GS_Ok();
+}
+
+double GS_PlaybackNextDeadline(GS_Playback *playback) {
+  if (playback->paused ||
+      playback->cursor == GS_LoaderCount(playback->loader)) {
+    return INFINITY;
+  }
+  double due = playback->lastTime + (playback->next - playback->position) /
+                                        playback->speed * 1000.;
+  double settled = playback->lastApply + GS_MIN_BATCH_INTERVAL_MS;
+  return due > settled ? due : settled;
+}
+
+bool GS_PlaybackFinished(GS_Playback *playback, double now) {
+  return GS_LoaderComplete(playback->loader) &&
+         playback->cursor == GS_LoaderCount(playback->loader) &&
+         now - playback->lastApply >= GS_SETTLE_TIME_MS;
+}
+
+void GS_ScalePlaybackSpeed(GS_Playback *playback, double factor) {
+  double speed = playback->speed * factor;
+  if (speed > 0 && isfinite(speed)) {
+    playback->speed = speed;
+  }
+}
+
+void GS_TogglePlaybackPause(GS_Playback *playback, double now) {
+  moveClock(playback, now);
+  playback->paused = !playback->paused;
+}
@@ -0,0 +1,79 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "loader.h"
+#include "status.h"
+
+typedef enum {
+  // commits are spread evenly, speed is given in commits per second
+  GS_PlaybackMode_Commits = 0,
+  // commits follow their timestamps, speed is given in seconds of history
+  // per second
+  GS_PlaybackMode_Time = 1,
+} GS_PlaybackMode;
+
+// Maps the simulation clock to a position in the history and decides which
+// commits are due. Clock values are given in milliseconds.
+typedef struct {
+  GS_Loader *loader;
+  GS_PlaybackMode mode;
+  double speed;
+  bool paused;
+
+  // index of the next commit to apply
+  uint64_t cursor;
+  // current position in the history and position of the next commit
+  double position;
+  double next;
+
+  double lastTime;
+  double lastApply;
+} GS_Playback;
+
+void GS_InitPlayback(GS_Playback *playback, GS_Loader *loader,
+                     GS_PlaybackMode mode, double speed, double now);
+
+// Moves the history position to now and takes the commits that are due.
+// Commits due while the previous batch is still settling are coalesced
+// into the next batch. Stores the first taken commit and the number of
+// taken commits. Commits taken before an error are still counted.
+GS_Status *GS_AdvancePlayback(GS_Playback *playback, double now,
+                              uint64_t *first, uint64_t *count);
+
+// Returns the clock value at which the next commit batch is due.
+double GS_PlaybackNextDeadline(GS_Playback *playback);
+
+bool GS_PlaybackFinished(GS_Playback *playback, double now);
+
+// Moves the cursor to the given commit, it is taken by the next advance.
+void GS_SeekPlayback(GS_Playback *playback, uint64_t commit, double now);
+
+// Moves the cursor back to a commit that was taken back. It is taken again
+// after its usual distance from the previous commit.
+GS_Status *GS_RewindPlayback(GS_Playback *playback, uint64_t commit,
+                             double now);
+
+void GS_ScalePlaybackSpeed(GS_Playback *playback, double factor);
+
+void GS_TogglePlaybackPause(GS_Playback *playback, double now);
@@ -0,0 +1,150 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "prefetch.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "utils.h"
+
+static GS_Status *buildBatch(GS_Loader *loader, uint64_t commit,
+                             GS_ChangeBatch **out) {
+  Config__CommitInfo *info;
+  GS_LockLoader(loader);
+  GS_Status *status = GS_LoadCommit(loader, commit, &info);
+  if (status->code == GS_StatusCode_OK) {
+    status = GS_CreateChangeBatch(info, commit, loader->dictionary, out);
+  }
+  GS_UnlockLoader(loader);
+  return status;
+}
+
+static int prefetchThread(void *data) {
+  GS_Prefetcher *prefetcher = data;
+  uint64_t epoch = atomic_load(&prefetcher->epoch);
+  uint64_t next = atomic_load(&prefetcher->start);
+  while (atomic_load(&prefetcher->working)) {
+    // the consumer stores start before it bumps the epoch
+    uint64_t current = atomic_load(&prefetcher->epoch);
+    if (current != epoch) {
+      epoch = current;
+      next = atomic_load(&prefetcher->start);
+    }
+    size_t tail = atomic_load(&prefetcher->tail);
+    if (next >= GS_LoaderCount(prefetcher->loader) ||
+        tail - atomic_load(&prefetcher->head) == prefetcher->capacity) {
+      SDL_SemWait(prefetcher->wakeup);
+      continue;
+    }
+    GS_ChangeBatch *batch;
+    GS_Status *status = buildBatch(prefetcher->loader, next, &batch);
+    if (status->code != GS_StatusCode_OK) {
+      // the consumer builds the commit itself and restarts after it
+      GS_WARN_NOT_OK(status)
+      next = GS_LoaderCount(prefetcher->loader);
+      continue;
+    }
+    batch->epoch = epoch;
+    prefetcher->ring[tail % prefetcher->capacity] = batch;
+    atomic_store(&prefetcher->tail, tail + 1);
+    next++;
+  }
+  return 0;
+}
+
+GS_Status *GS_CreatePrefetcher(GS_Loader *loader, size_t capacity,
+                               GS_Prefetcher **out) {
+  GS_Prefetcher *prefetcher = malloc(sizeof(GS_Prefetcher));
+  GS_NOT_NULL(prefetcher)
+  prefetcher->loader = loader;
+  prefetcher->capacity = capacity;
+  prefetcher->ring = malloc(sizeof(GS_ChangeBatch *) * capacity);
+  GS_NOT_NULL(prefetcher->ring)
+  atomic_init(&prefetcher->head, 0);
+  atomic_init(&prefetcher->tail, 0);
+  atomic_init(&prefetcher->epoch, 0);
+  atomic_init(&prefetcher->start, 0);
+  atomic_init(&prefetcher->working, true);
+  prefetcher->wakeup = SDL_CreateSemaphore(0);
+  GS_NOT_NULL(prefetcher->wakeup)
+  // commits of a stream keep arriving after the ring has caught up
+  GS_NotifyLoaderArrivals(loader, prefetcher->wakeup);
+  prefetcher->thread =
+      SDL_CreateThread(prefetchThread, "prefetch", prefetcher);
+  GS_NOT_NULL(prefetcher->thread)
+  *out = prefetcher;
+  return GS_Ok();
+}
+
+void GS_DestroyPrefetcher(GS_Prefetcher *prefetcher) {
+  GS_NotifyLoaderArrivals(prefetcher->loader, NULL);
+  atomic_store(&prefetcher->working, false);
+  SDL_SemPost(prefetcher->wakeup);
+  SDL_WaitThread(prefetcher->thread, NULL);
+  size_t tail = atomic_load(&prefetcher->tail);
+  for (size_t i = atomic_load(&prefetcher->head); i != tail; i++) {
+    GS_DestroyChangeBatch(prefetcher->ring[i % prefetcher->capacity]);
+  }
+  SDL_DestroySemaphore(prefetcher->wakeup);
+  free(prefetcher->ring);
+  free(prefetcher);
+}
+
+void GS_RestartPrefetch(GS_Prefetcher *prefetcher, uint64_t commit) {
+  atomic_store(&prefetcher->start, commit);
+  atomic_fetch_add(&prefetcher->epoch, 1);
+  SDL_SemPost(prefetcher->wakeup);
+}
+
+// Takes the oldest batch out of the ring, returns NULL if it is empty.
+static GS_ChangeBatch *pop(GS_Prefetcher *prefetcher) {
+  size_t head = atomic_load(&prefetcher->head);
+  size_t tail = atomic_load(&prefetcher->tail);
+  if (head == tail) {
+    return NULL;
+  }
+  GS_ChangeBatch *batch = prefetcher->ring[head % prefetcher->capacity];
+  atomic_store(&prefetcher->head, head + 1);
+  if (tail - head == prefetcher->capacity) {
+    SDL_SemPost(prefetcher->wakeup);
+  }
+  return batch;
+}
+
+GS_Status *GS_TakeChangeBatch(GS_Prefetcher *prefetcher, uint64_t commit,
+                              GS_ChangeBatch **out) {
+  uint64_t epoch = atomic_load(&prefetcher->epoch);
+  GS_ChangeBatch *batch;
+  while ((batch = pop(prefetcher)) != NULL) {
+    bool current = batch->epoch == epoch;
+    if (current && batch->commit == commit) {
+      *out = batch;
+      return GS_Ok();
+    }
+    bool ahead = current && batch->commit > commit;
+    GS_DestroyChangeBatch(batch);
+    if (ahead) {
+      break;
+    }
+  }
+  GS_RestartPrefetch(prefetcher, commit + 1);
+  return buildBatch(prefetcher->loader, commit, out);
+}
@@ -0,0 +1,71 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
+#include "changes.h"
+#include "loader.h"
+#include "status.h"
+
+// Builds the change batches of upcoming commits on a background thread and
+// hands them over through a lock-free single-producer single-consumer ring.
+// A restart bumps the epoch, batches of older epochs are dropped when they
+// are taken out of the ring.
+typedef struct {
+  GS_Loader *loader;
+
+  GS_ChangeBatch **ring;
+  size_t capacity;
+  // next slot to read, written by the consumer only
+  atomic_size_t head;
+  // next slot to write, written by the producer only
+  atomic_size_t tail;
+
+  // restart requests, written by the consumer only
+  atomic_ullong epoch;
+  atomic_ullong start;
+
+  atomic_bool working;
+  // posted when the ring gets room, when streamed commits arrive, on
+  // restarts and on shutdown
+  SDL_sem *wakeup;
+  SDL_Thread *thread;
+} GS_Prefetcher;
+
+// Starts preparing batches from the first commit, at most capacity of them
+// ahead of the consumer.
+GS_Status *GS_CreatePrefetcher(GS_Loader *loader, size_t capacity,
+                               GS_Prefetcher **out);
+
+void GS_DestroyPrefetcher(GS_Prefetcher *prefetcher);
+
+// Drops the prepared batches and continues from the given commit.
+void GS_RestartPrefetch(GS_Prefetcher *prefetcher, uint64_t commit);
+
+// Returns the batch of the commit, the caller destroys it. A batch that is
+// not ready yet is built on the calling thread and the prefetcher restarts
+// after it.
+GS_Status *GS_TakeChangeBatch(GS_Prefetcher *prefetcher, uint64_t commit,
+                              GS_ChangeBatch **out);
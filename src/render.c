@@ -20,6 +20,7 @@
 
 #include "render.h"
 
+#include <math.h>
 #include <stddef.h>
 
 #include "SDL2_gfx/SDL2_gfxPrimitives.h"
@@ -27,34 +28,106 @@
 #include "status.h"
 #include "vector.h"
 
-GS_Status *renderLine(SDL_Renderer *renderer, const GS_Object *obj1,
-                      const GS_Object *obj2) {
-  lineRGBA(renderer, obj1->center.x, obj1->center.y, obj2->center.x,
-           obj2->center.y, 0, 0, 0, 255);
+static GS_Status *renderLine(SDL_Renderer *renderer, const GS_Camera *camera,
+                             GS_Object *obj1, GS_Object *obj2) {
+  GS_Vec2 p1, p2;
+  GS_CameraWorldToScreen(camera, &obj1->center, &p1);
+  GS_CameraWorldToScreen(camera, &obj2->center, &p2);
+  lineRGBA(renderer, p1.x, p1.y, p2.x, p2.y, 0, 0, 0, 255);
   return GS_Ok();
 }
 
-GS_Status *renderCircle(SDL_Renderer *renderer, const GS_Object *obj) {
-  filledCircleRGBA(renderer, obj->center.x, obj->center.y, obj->radius,
-                   obj->color.r, obj->color.g, obj->color.b, obj->color.a);
+static GS_Status *renderCircle(SDL_Renderer *renderer, const GS_Camera *camera,
+                               GS_Object *obj) {
+  GS_Vec2 p;
+  GS_CameraWorldToScreen(camera, &obj->center, &p);
+  double radius = obj->radius * camera->zoom;
+  filledCircleRGBA(renderer, p.x, p.y, radius < 1 ? 1 : radius, obj->color.r,
+                   obj->color.g, obj->color.b, obj->color.a);
   return GS_Ok();
 }
 
-GS_Status *GS_RenderFile(SDL_Renderer *renderer, const GS_File *file) {
-  GS_RETURN_NOT_OK(renderCircle(renderer, &file->obj))
+static GS_Status *renderBlob(SDL_Renderer *renderer, const GS_Camera *camera,
+                             GS_Object *obj, size_t files) {
+  GS_Vec2 p;
+  GS_CameraWorldToScreen(camera, &obj->center, &p);
+  double radius = obj->radius * camera->zoom + sqrt(files);
+  if (radius > GS_LOD_PIXEL_THRESHOLD / 2) {
+    radius = GS_LOD_PIXEL_THRESHOLD / 2;
+  }
+  filledCircleRGBA(renderer, p.x, p.y, radius < 1 ? 1 : radius, obj->color.r,
+                   obj->color.g, obj->color.b, obj->color.a);
   return GS_Ok();
 }
 
-GS_Status *GS_RenderFolder(SDL_Renderer *renderer, const GS_Folder *folder) {
-  for (size_t i = 0; i < folder->files_count; i++) {
-    GS_RETURN_NOT_OK(renderLine(renderer, &folder->obj, &folder->files[i]->obj))
-    GS_RETURN_NOT_OK(GS_RenderFile(renderer, folder->files[i]))
+static bool isCollapsed(const GS_Camera *camera, GS_Snapshot *snapshot,
+                        size_t i) {
+  if (snapshot->is_file[i] || snapshot->parents[i] == i) {
+    return false;
+  }
+  GS_Rect *bounds = &snapshot->bounds[i];
+  double w = bounds->max.x - bounds->min.x;
+  double h = bounds->max.y - bounds->min.y;
+  return (w > h ? w : h) * camera->zoom < GS_LOD_PIXEL_THRESHOLD;
+}
+
+// Returns the topmost folder above (or at) the object whose subtree is too
+// small on screen to be drawn in detail, or the object itself if there is
+// no such folder. Ancestor bounds contain the bounds of their descendants,
+// so the walk stops at the first folder that is large enough.
+static size_t lodRepresentative(const GS_Camera *camera, GS_Snapshot *snapshot,
+                                size_t i) {
+  size_t rep = i;
+  size_t cur = snapshot->is_file[i] ? snapshot->parents[i] : i;
+  while (isCollapsed(camera, snapshot, cur)) {
+    rep = cur;
+    cur = snapshot->parents[cur];
+  }
+  return rep;
+}
+
+GS_Status *GS_RenderVisible(SDL_Renderer *renderer, const GS_Camera *camera,
+                            GS_Snapshot *snapshot, GS_Grid *grid) {
+  GS_Rect view, area;
+  GS_CameraVisibleRect(camera, &view);
+  // objects just outside of the view still have edges or circles crossing it
+  GS_RectExpand(&view, GS_CULLING_MARGIN, &area);
+  size_t count = GS_QueryGrid(grid, &area);
+
+  // replace objects inside collapsed subtrees with the subtree root and
+  // keep every subtree root only once
+  size_t drawn = 0;
+  for (size_t k = 0; k < count; k++) {
+    size_t rep = lodRepresentative(camera, snapshot, grid->result[k]);
+    if (GS_MarkGridItem(grid, rep)) {
+      grid->result[drawn++] = rep;
+    }
+  }
+  count = drawn;
+
+  for (size_t k = 0; k < count; k++) {
+    size_t i = grid->result[k];
+    size_t parent = snapshot->parents[i];
+    if (parent != i) {
+      GS_RETURN_NOT_OK(renderLine(renderer, camera, &snapshot->objects[parent],
+                                  &snapshot->objects[i]))
+    }
+  }
+  // folders are drawn over files attached to them
+  for (size_t k = 0; k < count; k++) {
+    size_t i = grid->result[k];
+    if (snapshot->is_file[i]) {
+      GS_RETURN_NOT_OK(renderCircle(renderer, camera, &snapshot->objects[i]))
+    }
   }
-  for (size_t i = 0; i < folder->folders_count; i++) {
-    GS_RETURN_NOT_OK(
-        renderLine(renderer, &folder->obj, &folder->folders[i]->obj))
-    GS_RETURN_NOT_OK(GS_RenderFolder(renderer, folder->folders[i]))
+  for (size_t k = 0; k < count; k++) {
+    size_t i = grid->result[k];
+    if (isCollapsed(camera, snapshot, i)) {
+      GS_RETURN_NOT_OK(renderBlob(renderer, camera, &snapshot->objects[i],
+                                  snapshot->weights[i]))
+    } else if (!snapshot->is_file[i]) {
+      GS_RETURN_NOT_OK(renderCircle(renderer, camera, &snapshot->objects[i]))
+    }
   }
-  GS_RETURN_NOT_OK(renderCircle(renderer, &folder->obj))
   return GS_Ok();
 }
@@ -21,9 +21,14 @@
 #pragma once
 
 #include "SDL_render.h"
-#include "objects.h"
+#include "camera.h"
+#include "grid.h"
+#include "snapshot.h"
 #include "utils.h"
 
-GS_Status *GS_RenderFile(SDL_Renderer *renderer, const GS_File *file);
-
-GS_Status *GS_RenderFolder(SDL_Renderer *renderer, const GS_Folder *folder);
\ No newline at end of file
+// Draws the snapshot objects that are visible through the camera. The grid
+// has to be built over the same objects. Folders whose
+// subtree is smaller than GS_LOD_PIXEL_THRESHOLD on screen are drawn as a
+// single blob sized by the number of files under them.
+GS_Status *GS_RenderVisible(SDL_Renderer *renderer, const GS_Camera *camera,
+                            GS_Snapshot *snapshot, GS_Grid *grid);
\ No newline at end of file
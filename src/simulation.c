@@ -0,0 +1,295 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "simulation.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "utils.h"
+
+static void applyCommit(GS_Simulation *sim, uint64_t index) {
+  GS_ChangeBatch *batch;
+  GS_Status *status = GS_TakeChangeBatch(sim->prefetcher, index, &batch);
+  if (status->code != GS_StatusCode_OK) {
+    GS_WARN_NOT_OK(status)
+    return;
+  }
+  GS_Undo *undo = GS_StartUndo(sim->undo, index);
+  GS_WARN_NOT_OK(GS_UpdateObjects(sim->wm, batch, undo))
+  GS_DestroyChangeBatch(batch);
+  GS_WARN_NOT_OK(GS_RecordKeyframe(sim->keyframes, sim->wm, index + 1))
+}
+
+static void applyCommits(GS_Simulation *sim, double now) {
+  uint64_t first;
+  uint64_t count;
+  GS_WARN_NOT_OK(GS_AdvancePlayback(&sim->playback, now, &first, &count))
+  for (uint64_t i = first; i < first + count; i++) {
+    applyCommit(sim, i);
+  }
+  if (count > 0) {
+    atomic_store(&sim->shown, first + count);
+  }
+}
+
+// Takes back the applied commits after target if all of them still have
+// undo records. Returns false if they do not.
+static bool takeBack(GS_Simulation *sim, uint64_t target, double now) {
+  uint64_t shown = atomic_load(&sim->shown);
+  if (target + 1 >= shown) {
+    return false;
+  }
+  for (uint64_t commit = target + 1; commit < shown; commit++) {
+    if (!GS_FindUndo(sim->undo, commit)) {
+      return false;
+    }
+  }
+  for (uint64_t commit = shown; commit-- > target + 1;) {
+    GS_Status *status =
+        GS_RevertObjects(sim->wm, GS_FindUndo(sim->undo, commit));
+    if (status->code != GS_StatusCode_OK) {
+      // the tree is only partially reverted, let the keyframe fix it
+      GS_WARN_NOT_OK(status)
+      return false;
+    }
+  }
+  GS_WARN_NOT_OK(GS_RewindPlayback(&sim->playback, target + 1, now))
+  GS_RestartPrefetch(sim->prefetcher, target + 1);
+  atomic_store(&sim->shown, target + 1);
+  return true;
+}
+
+// Applies at most GS_REPLAY_COMMITS of the commits before the replay
+// target and hands the target to playback once they are all applied.
+static void replay(GS_Simulation *sim, double now) {
+  uint64_t shown = atomic_load(&sim->shown);
+  uint64_t end = sim->replayTarget;
+  if (end - shown > GS_REPLAY_COMMITS) {
+    end = shown + GS_REPLAY_COMMITS;
+  }
+  for (uint64_t commit = shown; commit < end; commit++) {
+    applyCommit(sim, commit);
+  }
+  atomic_store(&sim->shown, end);
+  if (end == sim->replayTarget) {
+    sim->replaying = false;
+    GS_SeekPlayback(&sim->playback, end, now);
+  }
+}
+
+static GS_Status *seek(GS_Simulation *sim, uint64_t target, double now) {
+  uint64_t count = GS_LoaderCount(sim->loader);
+  if (count == 0) {
+    // nothing to seek to before the first commit arrives
+    return GS_Ok();
+  }
+  if (target >= count) {
+    target = count - 1;
+  }
+  sim->replaying = false;
+  uint64_t shown = atomic_load(&sim->shown);
+  if (target + 1 == shown) {
+    // the commit is already on the screen
+    return GS_RewindPlayback(&sim->playback, shown, now);
+  }
+  if (takeBack(sim, target, now)) {
+    return GS_Ok();
+  }
+  uint64_t keyframe = GS_KeyframeBefore(sim->keyframes, target);
+  if (target < shown || keyframe > shown) {
+    // the tree on the screen is past the target or further from it
+    GS_RETURN_NOT_OK(
+        GS_RestoreKeyframe(sim->keyframes, sim->wm, target, &keyframe))
+    GS_RestartPrefetch(sim->prefetcher, keyframe);
+    atomic_store(&sim->shown, keyframe);
+  }
+  // the settled layout on the screen is kept when going forward
+  sim->replaying = true;
+  sim->replayTarget = target;
+  replay(sim, now);
+  return GS_Ok();
+}
+
+GS_Status *GS_CreateSimulation(GS_WindowManager *wm, GS_Loader *loader,
+                               GS_Options *options, double now,
+                               GS_Simulation **out) {
+  GS_KeyframeStore *keyframes;
+  GS_RETURN_NOT_OK(GS_CreateKeyframeStore(GS_KEYFRAME_INTERVAL, &keyframes))
+  // keyframe of the empty tree, seeking to the start restores it
+  GS_DESTROY_AND_RETURN_NOT_OK(GS_RecordKeyframe(keyframes, wm, 0),
+                               GS_DestroyKeyframeStore(keyframes))
+  GS_UndoLog *undo;
+  GS_DESTROY_AND_RETURN_NOT_OK(GS_CreateUndoLog(GS_UNDO_DEPTH, &undo),
+                               GS_DestroyKeyframeStore(keyframes))
+  GS_Prefetcher *prefetcher;
+  GS_DESTROY_AND_RETURN_NOT_OK(
+      GS_CreatePrefetcher(loader, GS_PREFETCH_COMMITS, &prefetcher),
+      GS_DestroyKeyframeStore(keyframes);
+      GS_DestroyUndoLog(undo))
+  GS_Simulation *sim = malloc(sizeof(GS_Simulation));
+  GS_NOT_NULL(sim)
+  sim->wm = wm;
+  sim->loader = loader;
+  sim->prefetcher = prefetcher;
+  GS_InitPlayback(&sim->playback, loader, options->mode, options->speed, now);
+  sim->keyframes = keyframes;
+  sim->undo = undo;
+  sim->lastStep = now;
+  sim->replaying = false;
+  sim->replayTarget = 0;
+  atomic_init(&sim->speedSteps, 0);
+  atomic_init(&sim->pauseToggles, 0);
+  atomic_init(&sim->seekTarget, -1);
+  atomic_init(&sim->shown, 0);
+  atomic_init(&sim->working, false);
+  sim->thread = NULL;
+  applyCommits(sim, now);
+  *out = sim;
+  return GS_Ok();
+}
+
+void GS_DestroySimulation(GS_Simulation *sim) {
+  GS_DestroyPrefetcher(sim->prefetcher);
+  GS_DestroyKeyframeStore(sim->keyframes);
+  GS_DestroyUndoLog(sim->undo);
+  free(sim);
+}
+
+GS_Status *GS_AdvanceSimulation(GS_Simulation *sim, double now) {
+  int steps = atomic_exchange(&sim->speedSteps, 0);
+  if (steps != 0) {
+    GS_ScalePlaybackSpeed(&sim->playback, pow(GS_SPEED_STEP, steps));
+  }
+  if (atomic_exchange(&sim->pauseToggles, 0) % 2 != 0) {
+    GS_TogglePlaybackPause(&sim->playback, now);
+  }
+  long long target = atomic_exchange(&sim->seekTarget, -1);
+  if (target >= 0) {
+    GS_WARN_NOT_OK(seek(sim, target, now))
+  } else if (sim->replaying) {
+    replay(sim, now);
+  }
+  if (!sim->replaying) {
+    applyCommits(sim, now);
+  }
+
+  while (now - sim->lastStep >= GS_STEP_PERIOD_MS) {
+    sim->lastStep += GS_STEP_PERIOD_MS;
+    GS_RETURN_NOT_OK(GS_UpdateColors(sim->wm))
+    GS_RETURN_NOT_OK(GS_StepWindowManager(sim->wm))
+  }
+  return GS_Ok();
+}
+
+double GS_SimulationNextDeadline(GS_Simulation *sim) {
+  if (sim->replaying) {
+    // the replay goes on without waiting
+    return sim->lastStep;
+  }
+  double deadline = sim->lastStep + GS_STEP_PERIOD_MS;
+  double commit = GS_PlaybackNextDeadline(&sim->playback);
+  return commit < deadline ? commit : deadline;
+}
+
+bool GS_SimulationFinished(GS_Simulation *sim, double now) {
+  return !sim->replaying && GS_PlaybackFinished(&sim->playback, now);
+}
+
+void GS_SeekSimulation(GS_Simulation *sim, uint64_t commit) {
+  atomic_store(&sim->seekTarget, commit);
+}
+
+// Seeks relative to the commit on the screen.
+static void seekBy(GS_Simulation *sim, int64_t offset) {
+  uint64_t shown = atomic_load(&sim->shown);
+  uint64_t current = shown > 0 ? shown - 1 : 0;
+  if (offset < 0 && current < (uint64_t)-offset) {
+    GS_SeekSimulation(sim, 0);
+  } else {
+    GS_SeekSimulation(sim, current + offset);
+  }
+}
+
+bool GS_HandleSimulationEvent(GS_Simulation *sim, SDL_Event *event) {
+  if (event->type != SDL_KEYDOWN) {
+    return false;
+  }
+  switch (event->key.keysym.sym) {
+  case SDLK_HOME:
+    GS_SeekSimulation(sim, 0);
+    return true;
+  case SDLK_END:
+    if (GS_LoaderCount(sim->loader) > 0) {
+      GS_SeekSimulation(sim, GS_LoaderCount(sim->loader) - 1);
+    }
+    return true;
+  case SDLK_COMMA:
+    seekBy(sim, -1);
+    return true;
+  case SDLK_PERIOD:
+    seekBy(sim, 1);
+    return true;
+  case SDLK_PAGEUP:
+    seekBy(sim, -GS_SEEK_STEP);
+    return true;
+  case SDLK_PAGEDOWN:
+    seekBy(sim, GS_SEEK_STEP);
+    return true;
+  case SDLK_SPACE:
+    atomic_fetch_add(&sim->pauseToggles, 1);
+    return true;
+  case SDLK_LEFTBRACKET:
+    atomic_fetch_sub(&sim->speedSteps, 1);
+    return true;
+  case SDLK_RIGHTBRACKET:
+    atomic_fetch_add(&sim->speedSteps, 1);
+    return true;
+  default:
+    return false;
+  }
+}
+
+static int simulationThread(void *data) {
+  GS_Simulation *sim = data;
+  while (atomic_load(&sim->working)) {
+    double now = GS_GetTimeMs();
+    if (now - sim->lastStep > GS_MAX_CATCHUP_STEPS * GS_STEP_PERIOD_MS) {
+      // drop the backlog instead of falling further behind the wall clock
+      sim->lastStep = now - GS_STEP_PERIOD_MS;
+    }
+    GS_WARN_NOT_OK(GS_AdvanceSimulation(sim, now))
+    GS_SleepMs(GS_SimulationNextDeadline(sim) - GS_GetTimeMs());
+  }
+  return 0;
+}
+
+GS_Status *GS_StartSimulationThread(GS_Simulation *sim) {
+  atomic_store(&sim->working, true);
+  sim->thread = SDL_CreateThread(simulationThread, "simulation", sim);
+  GS_NOT_NULL(sim->thread)
+  return GS_Ok();
+}
+
+void GS_StopSimulationThread(GS_Simulation *sim) {
+  atomic_store(&sim->working, false);
+  SDL_WaitThread(sim->thread, NULL);
+  sim->thread = NULL;
+}
@@ -0,0 +1,98 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "SDL_events.h"
+#include "SDL_thread.h"
+#include "keyframes.h"
+#include "loader.h"
+#include "options.h"
+#include "playback.h"
+#include "prefetch.h"
+#include "status.h"
+#include "undo.h"
+#include "window_manager.h"
+
+// Applies commits and runs physics on its own clock given in milliseconds.
+// The render side only sees the snapshots it publishes through the window
+// manager.
+typedef struct {
+  GS_WindowManager *wm;
+  GS_Loader *loader;
+  GS_Prefetcher *prefetcher;
+  GS_Playback playback;
+  GS_KeyframeStore *keyframes;
+  GS_UndoLog *undo;
+  double lastStep;
+  // commit that playback resumes at once the replay reaches it
+  bool replaying;
+  uint64_t replayTarget;
+
+  // playback controls requested by the render thread and not yet applied
+  atomic_int speedSteps;
+  atomic_int pauseToggles;
+  atomic_llong seekTarget;
+  // number of applied commits, read by the render thread
+  atomic_ullong shown;
+
+  atomic_bool working;
+  SDL_Thread *thread;
+} GS_Simulation;
+
+// Creates a simulation and applies the first commit at the given time.
+GS_Status *GS_CreateSimulation(GS_WindowManager *wm, GS_Loader *loader,
+                               GS_Options *options, double now,
+                               GS_Simulation **out);
+
+void GS_DestroySimulation(GS_Simulation *sim);
+
+// Applies due commits and runs due physics steps up to now.
+GS_Status *GS_AdvanceSimulation(GS_Simulation *sim, double now);
+
+// Returns the time of the next physics step or commit, whichever is due
+// first.
+double GS_SimulationNextDeadline(GS_Simulation *sim);
+
+// Returns true once the last commit was applied and had time to settle.
+bool GS_SimulationFinished(GS_Simulation *sim, double now);
+
+// Asks the simulation to jump to the given commit. Short jumps back take
+// the applied commits back one by one, otherwise the commits are replayed
+// from the tree on the screen or from the nearest keyframe, whichever is
+// closer. The replay takes at most GS_REPLAY_COMMITS commits per step, so a
+// jump past the recorded keyframes reaches its target over several steps
+// and records the keyframes on the way.
+void GS_SeekSimulation(GS_Simulation *sim, uint64_t commit);
+
+// Handles playback keys: space pauses, '[' and ']' change the speed, ','
+// and '.' step one commit, Page Up and Page Down jump GS_SEEK_STEP commits,
+// Home and End go to the first and the last commit.
+// Returns true if the event was consumed. Safe to call from the render
+// thread while the simulation thread is running.
+bool GS_HandleSimulationEvent(GS_Simulation *sim, SDL_Event *event);
+
+// Advances the simulation on the wall clock in a separate thread.
+GS_Status *GS_StartSimulationThread(GS_Simulation *sim);
+
+void GS_StopSimulationThread(GS_Simulation *sim);
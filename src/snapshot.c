@@ -0,0 +1,120 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "snapshot.h"
+
+#include <stdlib.h>
+
+#include "utils.h"
+
+static void initSnapshot(GS_Snapshot *snapshot) {
+  snapshot->objects_count = 0;
+  snapshot->objects_capacity = GS_INITIAL_BALANCER_CAPACITY;
+  snapshot->objects = malloc(sizeof(GS_Object) * snapshot->objects_capacity);
+  GS_NOT_NULL(snapshot->objects)
+  snapshot->is_file = malloc(sizeof(bool) * snapshot->objects_capacity);
+  GS_NOT_NULL(snapshot->is_file)
+  snapshot->parents = malloc(sizeof(size_t) * snapshot->objects_capacity);
+  GS_NOT_NULL(snapshot->parents)
+  snapshot->bounds = malloc(sizeof(GS_Rect) * snapshot->objects_capacity);
+  GS_NOT_NULL(snapshot->bounds)
+  snapshot->weights = malloc(sizeof(size_t) * snapshot->objects_capacity);
+  GS_NOT_NULL(snapshot->weights)
+}
+
+static void reserveSnapshot(GS_Snapshot *snapshot, size_t count) {
+  if (count <= snapshot->objects_capacity) {
+    return;
+  }
+  while (snapshot->objects_capacity < count) {
+    snapshot->objects_capacity *= 2;
+  }
+  snapshot->objects = realloc(snapshot->objects,
+                              sizeof(GS_Object) * snapshot->objects_capacity);
+  GS_NOT_NULL(snapshot->objects)
+  snapshot->is_file =
+      realloc(snapshot->is_file, sizeof(bool) * snapshot->objects_capacity);
+  GS_NOT_NULL(snapshot->is_file)
+  snapshot->parents =
+      realloc(snapshot->parents, sizeof(size_t) * snapshot->objects_capacity);
+  GS_NOT_NULL(snapshot->parents)
+  snapshot->bounds =
+      realloc(snapshot->bounds, sizeof(GS_Rect) * snapshot->objects_capacity);
+  GS_NOT_NULL(snapshot->bounds)
+  snapshot->weights =
+      realloc(snapshot->weights, sizeof(size_t) * snapshot->objects_capacity);
+  GS_NOT_NULL(snapshot->weights)
+}
+
+static void freeSnapshot(GS_Snapshot *snapshot) {
+  free(snapshot->objects);
+  free(snapshot->is_file);
+  free(snapshot->parents);
+  free(snapshot->bounds);
+  free(snapshot->weights);
+}
+
+GS_Status *GS_CreateSnapshotBuffer(GS_SnapshotBuffer **out) {
+  GS_SnapshotBuffer *buffer = malloc(sizeof(GS_SnapshotBuffer));
+  GS_NOT_NULL(buffer)
+  for (int i = 0; i < GS_SNAPSHOT_BUFFERS; i++) {
+    initSnapshot(&buffer->buffers[i]);
+  }
+  buffer->front = 0;
+  atomic_init(&buffer->middle, 1);
+  buffer->back = 2;
+  *out = buffer;
+  return GS_Ok();
+}
+
+void GS_DestroySnapshotBuffer(GS_SnapshotBuffer *buffer) {
+  for (int i = 0; i < GS_SNAPSHOT_BUFFERS; i++) {
+    freeSnapshot(&buffer->buffers[i]);
+  }
+  free(buffer);
+}
+
+void GS_PublishSnapshot(GS_SnapshotBuffer *buffer, GS_Balancer *balancer) {
+  GS_Snapshot *snapshot = &buffer->buffers[buffer->back];
+  size_t count = balancer->objects_count;
+  reserveSnapshot(snapshot, count);
+  for (size_t i = 0; i < count; i++) {
+    snapshot->objects[i] = *balancer->objects[i];
+    snapshot->is_file[i] = balancer->is_file[i];
+    snapshot->parents[i] = balancer->parents[i];
+    snapshot->bounds[i] = balancer->bounds[i];
+    snapshot->weights[i] = balancer->weights[i];
+  }
+  snapshot->objects_count = count;
+
+  // the exchange releases the written buffer to the consumer
+  int previous =
+      atomic_exchange(&buffer->middle, buffer->back | GS_SNAPSHOT_FRESH);
+  buffer->back = previous & GS_SNAPSHOT_INDEX_MASK;
+}
+
+GS_Snapshot *GS_AcquireSnapshot(GS_SnapshotBuffer *buffer, bool *fresh) {
+  *fresh = (atomic_load(&buffer->middle) & GS_SNAPSHOT_FRESH) != 0;
+  if (*fresh) {
+    int previous = atomic_exchange(&buffer->middle, buffer->front);
+    buffer->front = previous & GS_SNAPSHOT_INDEX_MASK;
+  }
+  return &buffer->buffers[buffer->front];
+}
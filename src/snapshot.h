@@ -0,0 +1,68 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "objects.h"
+#include "phisics.h"
+#include "status.h"
+#include "vector.h"
+
+#define GS_SNAPSHOT_BUFFERS 3
+#define GS_SNAPSHOT_INDEX_MASK 3
+#define GS_SNAPSHOT_FRESH 4
+
+// Copy of everything the renderer needs from the balancer, so drawing
+// does not touch the tree while the simulation mutates it.
+typedef struct {
+  GS_Object *objects;
+  bool *is_file;
+  size_t *parents;
+  GS_Rect *bounds;
+  size_t *weights;
+  size_t objects_count;
+  size_t objects_capacity;
+} GS_Snapshot;
+
+// Lock-free triple buffer with one producer (simulation thread) and one
+// consumer (render thread). The producer fills the back buffer and swaps
+// it with the middle one, the consumer swaps the middle buffer with the
+// front one only when a newer snapshot was published.
+typedef struct {
+  GS_Snapshot buffers[GS_SNAPSHOT_BUFFERS];
+  // index of the middle buffer, GS_SNAPSHOT_FRESH is set until consumed
+  atomic_int middle;
+  int back;
+  int front;
+} GS_SnapshotBuffer;
+
+GS_Status *GS_CreateSnapshotBuffer(GS_SnapshotBuffer **out);
+
+void GS_DestroySnapshotBuffer(GS_SnapshotBuffer *buffer);
+
+// Copies traced objects into the back buffer and publishes it.
+void GS_PublishSnapshot(GS_SnapshotBuffer *buffer, GS_Balancer *balancer);
+
+// Returns the newest published snapshot. fresh is set if it was not
+// returned before.
+GS_Snapshot *GS_AcquireSnapshot(GS_SnapshotBuffer *buffer, bool *fresh);
@@ -26,9 +26,8 @@
 #include "utils.h"
 
 GS_Status *GS_Ok() {
-  static GS_Status ok;
-  ok.code = GS_StatusCode_OK;
-  ok.message = NULL;
+  // shared by all threads, so it is never written
+  static GS_Status ok = {GS_StatusCode_OK, NULL};
   return &ok;
 }
 
@@ -72,6 +71,30 @@ GS_Status *GS_IncorrectArgc(int received, int correct) {
   return status;
 }
 
+GS_Status *GS_IncorrectArgument(char *argument) {
+  GS_Status *status = allocStatus();
+  status->code = GS_StatusCode_IncorrectArgument;
+  snprintf(status->message, GS_STATUS_MAX_MESSAGE_SIZE,
+           "Incorrect argument: %s", argument);
+  return status;
+}
+
+GS_Status *GS_IOError(char *name) {
+  GS_Status *status = allocStatus();
+  status->code = GS_StatusCode_IOError;
+  snprintf(status->message, GS_STATUS_MAX_MESSAGE_SIZE,
+           "Input/output error on %s", name);
+  return status;
+}
+
+GS_Status *GS_CorruptedData(char *name) {
+  GS_Status *status = allocStatus();
+  status->code = GS_StatusCode_CorruptedData;
+  snprintf(status->message, GS_STATUS_MAX_MESSAGE_SIZE, "Corrupted data in %s",
+           name);
+  return status;
+}
+
 void GS_DestroyStatus(GS_Status *status) {
   if (status == GS_StatusCode_OK)
     return;
@@ -26,6 +26,9 @@ typedef enum {
   GS_StatusCode_NotFound = 1,
   GS_StatusCode_AlreadyExists = 2,
   GS_StatusCode_IncorrectArgc = 3,
+  GS_StatusCode_IncorrectArgument = 4,
+  GS_StatusCode_IOError = 5,
+  GS_StatusCode_CorruptedData = 6,
 } GS_StatusCode;
 
 typedef struct GS_Status {
@@ -84,4 +87,10 @@ GS_Status *GS_ObjectAlreadyExists(char *name);
 
 GS_Status *GS_IncorrectArgc(int received, int correct);
 
+GS_Status *GS_IncorrectArgument(char *argument);
+
+GS_Status *GS_IOError(char *name);
+
+GS_Status *GS_CorruptedData(char *name);
+
 void GS_DestroyStatus(GS_Status *status);
\ No newline at end of file
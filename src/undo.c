@@ -0,0 +1,98 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "undo.h"
+
+#include <stdlib.h>
+
+#include "utils.h"
+
+static void clearUndo(GS_Undo *undo) {
+  GS_ResetArena(undo->paths);
+  undo->created_count = 0;
+  undo->removed_count = 0;
+  undo->valid = false;
+}
+
+GS_Status *GS_CreateUndoLog(size_t depth, GS_UndoLog **out) {
+  GS_UndoLog *log = malloc(sizeof(GS_UndoLog));
+  GS_NOT_NULL(log)
+  log->depth = depth;
+  log->records = calloc(depth, sizeof(GS_Undo));
+  GS_NOT_NULL(log->records)
+  for (size_t i = 0; i < depth; i++) {
+    GS_RETURN_NOT_OK(
+        GS_CreateArena(GS_UNDO_ARENA_SIZE, &log->records[i].paths))
+  }
+  *out = log;
+  return GS_Ok();
+}
+
+void GS_DestroyUndoLog(GS_UndoLog *log) {
+  for (size_t i = 0; i < log->depth; i++) {
+    GS_DestroyArena(log->records[i].paths);
+    free(log->records[i].created);
+    free(log->records[i].removed);
+  }
+  free(log->records);
+  free(log);
+}
+
+GS_Undo *GS_StartUndo(GS_UndoLog *log, uint64_t commit) {
+  GS_Undo *undo = &log->records[commit % log->depth];
+  clearUndo(undo);
+  undo->commit = commit;
+  undo->valid = true;
+  return undo;
+}
+
+GS_Undo *GS_FindUndo(GS_UndoLog *log, uint64_t commit) {
+  GS_Undo *undo = &log->records[commit % log->depth];
+  if (!undo->valid || undo->commit != commit) {
+    return NULL;
+  }
+  return undo;
+}
+
+#define GS_RESERVE_SLOT(undo, field)                                           \
+  if (undo->field##_count == undo->field##_capacity) {                         \
+    undo->field##_capacity = undo->field##_capacity                            \
+                                 ? undo->field##_capacity * 2                  \
+                                 : GS_INITIAL_UNDO_CAPACITY;                   \
+    undo->field = realloc(undo->field,                                         \
+                          sizeof(*undo->field) * undo->field##_capacity);      \
+    GS_NOT_NULL(undo->field)                                                   \
+  }
+
+void GS_AddCreated(GS_Undo *undo, GS_Path *path, size_t depth,
+                   bool is_folder) {
+  GS_RESERVE_SLOT(undo, created)
+  GS_CreatedObject *created = &undo->created[undo->created_count++];
+  GS_CopyPath(path, depth, undo->paths, &created->path);
+  created->is_folder = is_folder;
+}
+
+void GS_AddRemoved(GS_Undo *undo, GS_Path *path, GS_File *file) {
+  GS_RESERVE_SLOT(undo, removed)
+  GS_RemovedFile *removed = &undo->removed[undo->removed_count++];
+  GS_CopyPath(path, path->depth, undo->paths, &removed->path);
+  removed->obj = file->obj;
+  removed->lines = file->lines;
+}
@@ -0,0 +1,82 @@
+// Copyright © 2020 Svetlana Emelianova
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "SDL_pixels.h"
+#include "arena.h"
+#include "objects.h"
+#include "path.h"
+#include "status.h"
+
+typedef struct {
+  GS_Path path;
+  bool is_folder;
+} GS_CreatedObject;
+
+typedef struct {
+  GS_Path path;
+  GS_Object obj;
+  uint64_t lines;
+} GS_RemovedFile;
+
+// Everything needed to take one commit back: the objects it created in
+// creation order, the files it removed with their last positions and the
+// color target it replaced. Paths are kept in the arena of the record.
+typedef struct {
+  uint64_t commit;
+  bool valid;
+  SDL_Color targetColor;
+  GS_Arena *paths;
+
+  GS_CreatedObject *created;
+  size_t created_count;
+  size_t created_capacity;
+
+  GS_RemovedFile *removed;
+  size_t removed_count;
+  size_t removed_capacity;
+} GS_Undo;
+
+// Undo records of the last depth applied commits, record of commit i lives
+// in slot i % depth.
+typedef struct {
+  GS_Undo *records;
+  size_t depth;
+} GS_UndoLog;
+
+GS_Status *GS_CreateUndoLog(size_t depth, GS_UndoLog **out);
+
+void GS_DestroyUndoLog(GS_UndoLog *log);
+
+// Clears the slot of the commit and returns it for filling.
+GS_Undo *GS_StartUndo(GS_UndoLog *log, uint64_t commit);
+
+// Returns the record of the commit or NULL if it was overwritten.
+GS_Undo *GS_FindUndo(GS_UndoLog *log, uint64_t commit);
+
+// Remembers the object at the path made of the first depth components.
+void GS_AddCreated(GS_Undo *undo, GS_Path *path, size_t depth,
+                   bool is_folder);
+
+void GS_AddRemoved(GS_Undo *undo, GS_Path *path, GS_File *file);
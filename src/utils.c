@@ -22,8 +22,8 @@
 
 #include <math.h>
 #include <stdlib.h>
-
-#include "status.h"
+#include <sys/time.h>
+#include <time.h>
 
 SDL_Color GS_MakeSDLColorRGBA(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
   SDL_Color result;
@@ -78,14 +78,6 @@ uint8_t GS_UpdateColorComponent(uint8_t curComponent, uint8_t targetComponent,
   return res;
 }
 
-GS_Status *GS_CheckArgc(int argc) {
-  int correctArgc = 2;
-  if (argc != correctArgc) {
-    return GS_IncorrectArgc(argc, correctArgc);
-  }
-  return GS_Ok();
-}
-
 void GS_RandomCirclePoint(GS_Vec2 *center, int radius, GS_Vec2 *res) {
   // x*x + y*y = R*R
   float x = rand() % radius;
@@ -98,4 +90,28 @@ void GS_RandomCirclePoint(GS_Vec2 *center, int radius, GS_Vec2 *res) {
   }
   res->x = center->x + x;
   res->y = center->y + y;
-}
\ No newline at end of file
+}
+
+double GS_GetTimeMs() {
+  struct timeval time;
+  gettimeofday(&time, NULL);
+  return time.tv_sec * 1000. + time.tv_usec / 1000.;
+}
+
+void GS_SleepMs(double ms) {
+  if (ms <= 0) {
+    return;
+  }
+  struct timespec time;
+  time.tv_sec = ms / 1000;
+  time.tv_nsec = (ms - time.tv_sec * 1000.) * 1000000;
+  nanosleep(&time, NULL);
+}
+
+uint64_t GS_ReadLittleEndian(uint8_t *data, size_t size) {
+  uint64_t res = 0;
+  for (size_t i = size; i-- > 0;) {
+    res = (res << 8) | data[i];
+  }
+  return res;
+}
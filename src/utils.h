@@ -19,6 +19,7 @@
 // SOFTWARE.
 
 #pragma once
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 
@@ -35,7 +36,38 @@
 // TODO: differentiate ticks and microtics
 // we don't need ticks to influence phisics speed as it now
 #define GS_MICROTICKS_PER_TICK 30
+// default playback speed is one commit per GS_COMMITS_INTERVAL seconds
 #define GS_COMMITS_INTERVAL 7
+#define GS_MIN_BATCH_INTERVAL_MS 200.
+#define GS_MAX_IDLE_SECONDS 2.
+#define GS_SETTLE_TIME_MS (GS_COMMITS_INTERVAL * 1000.)
+#define GS_SPEED_STEP 2.
+#define GS_SEEK_STEP 100
+#define GS_KEYFRAME_INTERVAL 256
+#define GS_INITIAL_KEYFRAMES_CAPACITY 64
+#define GS_INITIAL_KEYFRAME_SIZE 4096
+// commits replayed per simulation step on the way to a seek target
+#define GS_REPLAY_COMMITS GS_KEYFRAME_INTERVAL
+// deeper jumps back restore a keyframe instead
+#define GS_UNDO_DEPTH GS_KEYFRAME_INTERVAL
+#define GS_INITIAL_UNDO_CAPACITY 16
+#define GS_UNDO_ARENA_SIZE 1024
+#define GS_LOOKAHEAD_COMMITS 1024
+#define GS_INITIAL_OFFSETS_CAPACITY 1024
+#define GS_RECORD_ARENA_SIZE 4096
+#define GS_STREAM_CHUNK_SIZE 65536
+// how often the reader thread checks whether it should stop
+#define GS_STREAM_POLL_MS 100
+// inflated blocks kept around the one being read
+#define GS_PREFETCH_BLOCKS 4
+// change batches the prefetch thread prepares ahead
+#define GS_PREFETCH_COMMITS 64
+#define GS_DICTIONARY_ARENA_SIZE 65536
+#define GS_INITIAL_DICTIONARY_CAPACITY 1024
+#define GS_MAX_PATH_DEPTH 256
+#define GS_STEP_PERIOD_MS                                                      \
+  (1000. / GS_TICS_PER_SECOND / GS_MICROTICKS_PER_TICK)
+#define GS_MAX_CATCHUP_STEPS GS_MICROTICKS_PER_TICK
 #define GS_SPEED_DAMPING 0.99
 
 #define GS_FOLDER_CHARGE 4000
@@ -46,6 +78,24 @@
 #define GS_FILE_FOLDER_SPRING_LENTH 64
 #define GS_FOLDER_FOLDER_SPRING_LENTH 256
 
+#define GS_INITIAL_GRID_CAPACITY 1024
+#define GS_GRID_CELL_SIZE 256.0
+#define GS_CULLING_MARGIN                                                      \
+  (GS_FOLDER_FOLDER_SPRING_LENTH + 2 * GS_FOLDER_RADIUS)
+
+#define GS_CAMERA_PAN_STEP 64
+#define GS_CAMERA_ZOOM_STEP 1.25
+#define GS_CAMERA_MIN_ZOOM 0.01
+#define GS_CAMERA_MAX_ZOOM 16.0
+#define GS_LOD_PIXEL_THRESHOLD 24.0
+// objects move this far before the bounds of their folders are updated
+#define GS_BOUNDS_MARGIN 4.0
+
+#define GS_WINDOW_WIDTH 1920
+#define GS_WINDOW_HEIGHT 1080
+#define GS_EXPORT_FPS 60
+#define GS_FRAMES_PER_SECOND 60
+
 #define GS_PANIC_ON_ERROR(expr)                                                \
   {                                                                            \
     int M_err = expr;                                                          \
@@ -78,6 +128,14 @@ uint8_t GS_UpdateColorComponent(uint8_t curComponent, uint8_t targetComponent,
                                 int8_t step);
 
 typedef struct GS_Status GS_Status;
-GS_Status *GS_CheckArgc(int argc);
 
 void GS_RandomCirclePoint(GS_Vec2 *center, int radius, GS_Vec2 *res);
+
+double GS_GetTimeMs();
+
+// Sleeps for the given number of milliseconds, returns at once if it is
+// not positive.
+void GS_SleepMs(double ms);
+
+// Reads an unsigned little-endian integer of size bytes.
+uint64_t GS_ReadLittleEndian(uint8_t *data, size_t size);
@@ -55,3 +55,27 @@ GS_Vec2 GS_VecMake(double x, double y) {
   v.y = y;
   return v;
 }
+
+GS_Rect GS_RectMake(double x1, double y1, double x2, double y2) {
+  GS_Rect r;
+  r.min = GS_VecMake(x1 < x2 ? x1 : x2, y1 < y2 ? y1 : y2);
+  r.max = GS_VecMake(x1 < x2 ? x2 : x1, y1 < y2 ? y2 : y1);
+  return r;
+}
+
+void GS_RectExpand(GS_Rect *rect, double margin, GS_Rect *res) {
+  res->min = GS_VecMake(rect->min.x - margin, rect->min.y - margin);
+  res->max = GS_VecMake(rect->max.x + margin, rect->max.y + margin);
+}
+
+bool GS_RectContains(GS_Rect *rect, GS_Vec2 *point) {
+  return point->x >= rect->min.x && point->x <= rect->max.x &&
+         point->y >= rect->min.y && point->y <= rect->max.y;
+}
+
+void GS_RectUnion(GS_Rect *lhs, GS_Rect *rhs, GS_Rect *res) {
+  res->min.x = lhs->min.x < rhs->min.x ? lhs->min.x : rhs->min.x;
+  res->min.y = lhs->min.y < rhs->min.y ? lhs->min.y : rhs->min.y;
+  res->max.x = lhs->max.x > rhs->max.x ? lhs->max.x : rhs->max.x;
+  res->max.y = lhs->max.y > rhs->max.y ? lhs->max.y : rhs->max.y;
+}
@@ -19,12 +19,18 @@
 // SOFTWARE.
 
 #pragma once
+#include <stdbool.h>
 
 typedef struct {
   double x;
   double y;
 } GS_Vec2;
 
+typedef struct {
+  GS_Vec2 min;
+  GS_Vec2 max;
+} GS_Rect;
+
 void GS_VecSum(GS_Vec2 *lhs, GS_Vec2 *rhs, GS_Vec2 *res);
 
 void GS_VecDif(GS_Vec2 *lhs, GS_Vec2 *rhs, GS_Vec2 *res);
@@ -38,3 +44,11 @@ double GS_VecLen(GS_Vec2 *vec);
 void GS_VecNorm(GS_Vec2 *vec, GS_Vec2 *res);
 
 GS_Vec2 GS_VecMake(double x, double y);
+
+GS_Rect GS_RectMake(double x1, double y1, double x2, double y2);
+
+void GS_RectExpand(GS_Rect *rect, double margin, GS_Rect *res);
+
+bool GS_RectContains(GS_Rect *rect, GS_Vec2 *point);
+
+void GS_RectUnion(GS_Rect *lhs, GS_Rect *rhs, GS_Rect *res);
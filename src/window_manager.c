@@ -28,45 +28,108 @@
 #include "utils.h"
 #include "vector.h"
 
-GS_Status *GS_CreateWindowManager(int w, int h, GS_WindowManager **out) {
+static GS_Status *createWindowManager(int w, int h, GS_WindowManager **out) {
   GS_Folder *root;
   GS_RETURN_NOT_OK(GS_CreateFolder("root", NULL, &root))
   GS_Balancer *balancer;
   GS_DESTROY_AND_RETURN_NOT_OK(GS_CreateBalancer(&balancer),
                                GS_DestroyFolder(root))
+  GS_Grid *grid;
+  GS_DESTROY_AND_RETURN_NOT_OK(GS_CreateGrid(GS_GRID_CELL_SIZE, &grid),
+                               GS_DestroyFolder(root);
+                               GS_DestroyBalancer(balancer))
+  GS_SnapshotBuffer *snapshots;
+  GS_DESTROY_AND_RETURN_NOT_OK(GS_CreateSnapshotBuffer(&snapshots),
+                               GS_DestroyFolder(root);
+                               GS_DestroyBalancer(balancer);
+                               GS_DestroyGrid(grid))
   GS_WindowManager *wm = malloc(sizeof(GS_WindowManager));
   GS_NOT_NULL(wm);
   wm->root = root;
   wm->balancer = balancer;
+  wm->grid = grid;
+  wm->snapshots = snapshots;
+  GS_InitCamera(&wm->camera, w, h);
+  wm->redraw = true;
   root->obj.center.x = w / 2;
   root->obj.center.y = h / 2;
+  wm->window = NULL;
+  wm->surface = NULL;
+  wm->renderer = NULL;
+  wm->currentColor = GS_MakeSDLColorRGB(0, 255, 0);
+  wm->targetColor = GS_MakeSDLColorRGB(0, 255, 0);
+  *out = wm;
+  return GS_Ok();
+}
+
+GS_Status *GS_CreateWindowManager(int w, int h, GS_WindowManager **out) {
+  GS_WindowManager *wm;
+  GS_RETURN_NOT_OK(createWindowManager(w, h, &wm))
   wm->window =
       SDL_CreateWindow("Git Stories", SDL_WINDOWPOS_CENTERED,
                        SDL_WINDOWPOS_CENTERED, w, h, SDL_WINDOW_OPENGL);
   GS_NOT_NULL(wm->window);
-  wm->renderer = SDL_CreateRenderer(wm->window, -1, 0);
+  // vsync only paces the render thread, the simulation runs on its own
+  wm->renderer =
+      SDL_CreateRenderer(wm->window, -1, SDL_RENDERER_PRESENTVSYNC);
+  GS_NOT_NULL(wm->renderer);
+  *out = wm;
+  return GS_Ok();
+}
+
+GS_Status *GS_CreateOffscreenWindowManager(int w, int h,
+                                           GS_WindowManager **out) {
+  GS_WindowManager *wm;
+  GS_RETURN_NOT_OK(createWindowManager(w, h, &wm))
+  wm->surface =
+      SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGBA32);
+  GS_NOT_NULL(wm->surface);
+  wm->renderer = SDL_CreateSoftwareRenderer(wm->surface);
   GS_NOT_NULL(wm->renderer);
-  wm->currentColor = GS_MakeSDLColorRGB(0, 255, 0);
-  wm->targetColor = GS_MakeSDLColorRGB(0, 255, 0);
   *out = wm;
   return GS_Ok();
 }
+
 void GS_DestroyWindowManager(GS_WindowManager *wm) {
   SDL_DestroyRenderer(wm->renderer);
-  SDL_DestroyWindow(wm->window);
+  if (wm->window) {
+    SDL_DestroyWindow(wm->window);
+  }
+  if (wm->surface) {
+    SDL_FreeSurface(wm->surface);
+  }
   GS_DestroyFolder(wm->root);
   GS_DestroyBalancer(wm->balancer);
+  GS_DestroyGrid(wm->grid);
+  GS_DestroySnapshotBuffer(wm->snapshots);
   free(wm);
 }
 
-GS_Status *GS_UpdateWindowManager(GS_WindowManager *wm) {
-  SDL_SetRenderDrawColor(wm->renderer, 255, 255, 255, 255);
-  SDL_RenderClear(wm->renderer);
+GS_Status *GS_StepWindowManager(GS_WindowManager *wm) {
   GS_ClearBalancer(wm->balancer);
   GS_TraceObjects(wm->balancer, wm->root);
   GS_Balance(wm->balancer);
+  GS_PublishSnapshot(wm->snapshots, wm->balancer);
+  return GS_Ok();
+}
 
-  GS_RETURN_NOT_OK(GS_RenderFolder(wm->renderer, wm->root))
+GS_Status *GS_RenderWindowManager(GS_WindowManager *wm) {
+  bool fresh;
+  GS_Snapshot *snapshot = GS_AcquireSnapshot(wm->snapshots, &fresh);
+  if (!fresh && !wm->redraw) {
+    return GS_Ok();
+  }
+  wm->redraw = false;
+
+  SDL_SetRenderDrawColor(wm->renderer, 255, 255, 255, 255);
+  SDL_RenderClear(wm->renderer);
+  if (fresh) {
+    // the front snapshot only changes when a new one is acquired
+    GS_RebuildGrid(wm->grid, snapshot->objects, snapshot->objects_count);
+  }
+
+  GS_RETURN_NOT_OK(
+      GS_RenderVisible(wm->renderer, &wm->camera, snapshot, wm->grid))
 
   SDL_RenderPresent(wm->renderer);
 
@@ -79,57 +142,104 @@ GS_Status *GS_UpdateColors(GS_WindowManager *wm) {
   return GS_Ok();
 }
 
-GS_Status *GS_UpdateObjects(GS_WindowManager *wm, Config__CommitInfo *commit) {
-  char *delim = "/";
-  GS_Folder *parent = wm->root;
+bool GS_HandleWindowEvent(GS_WindowManager *wm, SDL_Event *event) {
+  if (GS_CameraHandleEvent(&wm->camera, event)) {
+    wm->redraw = true;
+    return true;
+  }
+  return false;
+}
 
-  for (int i = 0; i < commit->n_newfiles; i++) {
-    char *ptr = strtok(commit->newfiles[i], delim);
-    char *next;
-
-    while (1) {
-      next = strtok(NULL, delim);
-      if (next != NULL) {
-        GS_Folder *f;
-        if (!GS_NameExists(parent, ptr)) {
-          GS_WARN_NOT_OK(GS_CreateFolder(ptr, parent, &f))
-        } else {
-          GS_WARN_NOT_OK(GS_FindFolder(parent, ptr, &f))
-        }
-        if (f) {
-          parent = f;
-        }
-        ptr = next;
-      } else {
-        GS_File *file;
-        GS_WARN_NOT_OK(GS_CreateFile(parent, ptr, &file))
-        parent = wm->root;
-        break;
+static GS_Status *addFile(GS_WindowManager *wm, GS_Path *path,
+                          GS_Undo *undo) {
+  GS_Folder *parent = wm->root;
+  for (size_t i = 0; i + 1 < path->depth; i++) {
+    char *name = GS_PathComponent(path, i);
+    GS_Folder *f = GS_LookupFolder(parent, name, path->hashes[i]);
+    if (!f) {
+      if (GS_LookupFile(parent, name, path->hashes[i])) {
+        return GS_FolderNotFound(name);
+      }
+      GS_RETURN_NOT_OK(GS_AppendFolder(name, parent, &f))
+      if (undo) {
+        GS_AddCreated(undo, path, i + 1, true);
       }
     }
+    parent = f;
   }
+  size_t last = path->depth - 1;
+  char *name = GS_PathComponent(path, last);
+  if (GS_LookupFile(parent, name, path->hashes[last]) ||
+      GS_LookupFolder(parent, name, path->hashes[last])) {
+    return GS_ObjectAlreadyExists(name);
+  }
+  GS_File *file;
+  GS_RETURN_NOT_OK(GS_AppendFile(parent, name, &file))
+  if (undo) {
+    GS_AddCreated(undo, path, path->depth, false);
+  }
+  return GS_Ok();
+}
 
-  for (int i = 0; i < commit->n_deletedfiles; i++) {
-    char *ptr = strtok(commit->deletedfiles[i], delim);
-    char *next;
-
-    while (1) {
-      next = strtok(NULL, delim);
-      if (next != NULL) {
-        GS_Folder *f;
-        GS_WARN_NOT_OK(GS_FindFolder(parent, ptr, &f))
-        if (f) {
-          parent = f;
-        }
-        ptr = next;
-      } else {
-        GS_WARN_NOT_OK(GS_RemoveFile(parent, ptr))
-        parent = wm->root;
-        break;
-      }
+static GS_Status *removeFile(GS_WindowManager *wm, GS_Path *path,
+                             GS_Undo *undo) {
+  GS_Folder *parent;
+  GS_RETURN_NOT_OK(GS_WalkPath(wm->root, path, path->depth, &parent))
+  size_t last = path->depth - 1;
+  char *name = GS_PathComponent(path, last);
+  GS_File *file = GS_LookupFile(parent, name, path->hashes[last]);
+  if (!file) {
+    return GS_FileNotFound(name);
+  }
+  if (undo) {
+    GS_AddRemoved(undo, path, file);
+  }
+  return GS_RemoveFile(parent, name);
+}
+
+GS_Status *GS_UpdateObjects(GS_WindowManager *wm, GS_ChangeBatch *batch,
+                            GS_Undo *undo) {
+  if (undo) {
+    undo->targetColor = wm->targetColor;
+  }
+  for (size_t i = 0; i < batch->added_count; i++) {
+    GS_WARN_NOT_OK(addFile(wm, &batch->added[i], undo))
+  }
+  for (size_t i = 0; i < batch->removed_count; i++) {
+    GS_WARN_NOT_OK(removeFile(wm, &batch->removed[i], undo))
+  }
+  wm->targetColor = GS_CalculateColor(batch->errors);
+  return GS_Ok();
+}
+
+GS_Status *GS_RevertObjects(GS_WindowManager *wm, GS_Undo *undo) {
+  GS_Folder *parent;
+
+  for (size_t i = undo->removed_count; i-- > 0;) {
+    GS_RemovedFile *removed = &undo->removed[i];
+    GS_Path *path = &removed->path;
+    GS_RETURN_NOT_OK(GS_WalkPath(wm->root, path, path->depth, &parent))
+    GS_File *file;
+    GS_RETURN_NOT_OK(GS_CreateFile(
+        parent, GS_PathComponent(path, path->depth - 1), &file))
+    file->obj.center = removed->obj.center;
+    file->obj.speed = removed->obj.speed;
+    file->obj.color = wm->currentColor;
+    file->lines = removed->lines;
+  }
+
+  for (size_t i = undo->created_count; i-- > 0;) {
+    GS_CreatedObject *created = &undo->created[i];
+    GS_Path *path = &created->path;
+    GS_RETURN_NOT_OK(GS_WalkPath(wm->root, path, path->depth, &parent))
+    char *name = GS_PathComponent(path, path->depth - 1);
+    if (created->is_folder) {
+      GS_RETURN_NOT_OK(GS_RemoveFolder(parent, name))
+    } else {
+      GS_RETURN_NOT_OK(GS_RemoveFile(parent, name))
     }
   }
 
-  wm->targetColor = GS_CalculateColor(commit->errors);
+  wm->targetColor = undo->targetColor;
   return GS_Ok();
 }
@@ -19,29 +19,64 @@
 // SOFTWARE.
 
 #pragma once
+#include <stdbool.h>
+
+#include "SDL_events.h"
 #include "SDL_pixels.h"
 #include "SDL_render.h"
+#include "SDL_surface.h"
 #include "SDL_video.h"
-#include "config.pb-c.h"
+#include "camera.h"
+#include "changes.h"
+#include "grid.h"
 #include "objects.h"
 #include "phisics.h"
+#include "snapshot.h"
 #include "status.h"
+#include "undo.h"
 
 typedef struct {
+  // owned by the render thread, either window or surface is set
   SDL_Window *window;
+  SDL_Surface *surface;
   SDL_Renderer *renderer;
+  GS_Grid *grid;
+  GS_Camera camera;
+  bool redraw;
+
+  // owned by the simulation thread
   GS_Folder *root;
   GS_Balancer *balancer;
   SDL_Color currentColor;
   SDL_Color targetColor;
+
+  GS_SnapshotBuffer *snapshots;
 } GS_WindowManager;
 
 GS_Status *GS_CreateWindowManager(int w, int h, GS_WindowManager **out);
 
+// Renders into an RGBA32 surface with the software renderer, no display
+// is required.
+GS_Status *GS_CreateOffscreenWindowManager(int w, int h,
+                                           GS_WindowManager **out);
+
 void GS_DestroyWindowManager(GS_WindowManager *wm);
 
-GS_Status *GS_UpdateWindowManager(GS_WindowManager *wm);
+// Moves objects one physics step and publishes their snapshot.
+GS_Status *GS_StepWindowManager(GS_WindowManager *wm);
+
+// Draws the newest published snapshot if it was not drawn yet.
+GS_Status *GS_RenderWindowManager(GS_WindowManager *wm);
 
 GS_Status *GS_UpdateColors(GS_WindowManager *wm);
 
-GS_Status *GS_UpdateObjects(GS_WindowManager *wm, Config__CommitInfo *commit);
+bool GS_HandleWindowEvent(GS_WindowManager *wm, SDL_Event *event);
+
+// Applies the change batch of a commit to the tree. If undo is not NULL it
+// is filled with what GS_RevertObjects needs to take the commit back.
+GS_Status *GS_UpdateObjects(GS_WindowManager *wm, GS_ChangeBatch *batch,
+                            GS_Undo *undo);
+
+// Takes back the commit recorded in undo; removed files reappear where
+// they were.
+GS_Status *GS_RevertObjects(GS_WindowManager *wm, GS_Undo *undo);